@@ -21,6 +21,7 @@
 #include "clang/AST/Decl.h"
 #include "clang/AST/LambdaMangleContext.h"
 #include "clang/AST/NestedNameSpecifier.h"
+#include "clang/AST/ParentIndex.h"
 #include "clang/AST/PrettyPrinter.h"
 #include "clang/AST/RawCommentList.h"
 #include "clang/AST/RecursiveASTVisitor.h"
@@ -58,8 +59,11 @@ namespace clang {
   class SelectorTable;
   class TargetInfo;
   class CXXABI;
+  class CXXBaseSet;
+  class ConstexprCallCache;
   // Decls
   class MangleContext;
+  class MemoryReport;
   class ObjCIvarDecl;
   class ObjCPropertyDecl;
   class UnresolvedSetIterator;
@@ -134,7 +138,9 @@ class ASTContext : public RefCountedBase<ASTContext> {
 
   /// \brief A cache mapping from RecordDecls to ASTRecordLayouts.
   ///
-  /// This is lazily created.  This is intentionally not serialized.
+  /// This is lazily created. The layouts themselves are not serialized, but
+  /// the offsets they contain are written to AST files and handed back
+  /// through ExternalASTSource::layoutRecordType.
   mutable llvm::DenseMap<const RecordDecl*, const ASTRecordLayout*>
     ASTRecordLayouts;
   mutable llvm::DenseMap<const ObjCContainerDecl*, const ASTRecordLayout*>
@@ -163,6 +169,18 @@ class ASTContext : public RefCountedBase<ASTContext> {
   llvm::DenseMap<const FunctionDecl*, FunctionDecl*>
     ClassScopeSpecializationPattern;
 
+  /// \brief Mapping from functions to the declarations in their prototype
+  /// scope that are not parameters.
+  ///
+  /// Only C functions that declare a tag in their parameter list have such
+  /// declarations, so they are kept here rather than in every FunctionDecl.
+  llvm::DenseMap<const FunctionDecl*, ArrayRef<NamedDecl *> >
+    DeclsInPrototypeScope;
+
+  /// \brief Mapping from class definitions to the set of all their base
+  /// classes, computed when first needed.
+  llvm::DenseMap<const CXXRecordDecl*, const CXXBaseSet *> CXXBaseSets;
+
   /// \brief Representation of a "canonical" template template parameter that
   /// is used in canonical template names.
   class CanonicalTemplateTemplateParm : public llvm::FoldingSetNode {
@@ -365,6 +383,9 @@ class ASTContext : public RefCountedBase<ASTContext> {
   OwningPtr<CXXABI> ABI;
   CXXABI *createCXXABI(const TargetInfo &T);
 
+  /// \brief The results of constexpr function calls, created on demand.
+  mutable OwningPtr<ConstexprCallCache> ConstexprCalls;
+
   /// \brief The logical -> physical address space map.
   const LangAS::Map *AddrSpaceMap;
 
@@ -387,9 +408,6 @@ public:
   /// \brief Contains parents of a node.
   typedef llvm::SmallVector<ast_type_traits::DynTypedNode, 1> ParentVector;
 
-  /// \brief Maps from a node to its parents.
-  typedef llvm::DenseMap<const void *, ParentVector> ParentMap;
-
   /// \brief Returns the parents of the given node.
   ///
   /// Note that this will lazily compute the parents of all nodes
@@ -419,22 +437,14 @@ public:
     return getParents(ast_type_traits::DynTypedNode::create(Node));
   }
 
-  ParentVector getParents(const ast_type_traits::DynTypedNode &Node) {
-    assert(Node.getMemoizationData() &&
-           "Invariant broken: only nodes that support memoization may be "
-           "used in the parent map.");
-    if (!AllParents) {
-      // We always need to run over the whole translation unit, as
-      // hasAncestor can escape any subtree.
-      AllParents.reset(
-          ParentMapASTVisitor::buildMap(*getTranslationUnitDecl()));
-    }
-    ParentMap::const_iterator I = AllParents->find(Node.getMemoizationData());
-    if (I == AllParents->end()) {
-      return ParentVector();
-    }
-    return I->second;
-  }
+  ParentVector getParents(const ast_type_traits::DynTypedNode &Node);
+
+  /// \brief Returns the index of the parents of all nodes, computing it if
+  /// needed.
+  ///
+  /// Clients that walk up several levels of the AST should use the IDs in the
+  /// index, which avoids looking up each ancestor in a map.
+  const ParentIndex &getParentIndex();
 
   const clang::PrintingPolicy &getPrintingPolicy() const {
     return PrintingPolicy;
@@ -463,11 +473,28 @@ public:
   }
   /// Return the total memory used for various side tables.
   size_t getSideTableAllocatedMemory() const;
+
+  /// \brief Return the memory used by the DeclContext lookup tables, which
+  /// are allocated on the heap rather than by the AST allocator.
+  size_t getDeclContextMapsMemory(unsigned &NumMaps, unsigned &NumNames,
+                                  unsigned &NumVectors) const;
+
+  /// \brief Add the memory used by this ASTContext to the given report,
+  /// broken down by declaration, statement and type kind.
+  ///
+  /// Declarations and statements are found by walking the translation unit
+  /// without deserializing anything; nodes loaded from AST files are not
+  /// counted individually.
+  void reportMemoryUsage(MemoryReport &Report) const;
   
   PartialDiagnostic::StorageAllocator &getDiagAllocator() {
     return DiagAllocator;
   }
 
+  /// \brief Retrieve the results of constexpr function calls remembered by
+  /// the constant evaluator.
+  ConstexprCallCache &getConstexprCallCache() const;
+
   const TargetInfo &getTargetInfo() const { return *Target; }
   
   const LangOptions& getLangOpts() const { return LangOpts; }
@@ -609,6 +636,22 @@ public:
   void setClassScopeSpecializationPattern(FunctionDecl *FD,
                                           FunctionDecl *Pattern);
 
+  /// \brief Retrieve the declarations in the prototype scope of the given
+  /// function that are not parameters.
+  ArrayRef<NamedDecl *> getDeclsInPrototypeScope(const FunctionDecl *FD) const;
+
+  /// \brief Note the declarations in the prototype scope of the given
+  /// function that are not parameters.
+  void setDeclsInPrototypeScope(const FunctionDecl *FD,
+                                ArrayRef<NamedDecl *> Decls);
+
+  /// \brief Retrieve the set of all direct and indirect base classes of the
+  /// given class definition.
+  ///
+  /// Returns null if the set cannot be computed, because the class is not
+  /// complete or is dependent, or because one of its bases is not defined.
+  const CXXBaseSet *getCXXBaseSet(const CXXRecordDecl *RD);
+
   /// \brief Note that the static data member \p Inst is an instantiation of
   /// the static data member template \p Tmpl of a class template.
   void setInstantiatedFromStaticDataMember(VarDecl *Inst, VarDecl *Tmpl,
@@ -2128,6 +2171,15 @@ public:
   /// \brief The number of implicitly-declared destructors for which 
   /// declarations were built.
   static unsigned NumImplicitDestructorsDeclared;
+
+  /// \brief The number of types compared with a profile being looked up in
+  /// the uniquing tables of function prototypes and template
+  /// specializations.
+  static unsigned NumUniquingCandidates;
+
+  /// \brief The number of those types that were rejected by the hash of their
+  /// profile, without recomputing the profile.
+  static unsigned NumUniquingCandidatesRejectedByHash;
   
 private:
   ASTContext(const ASTContext &) LLVM_DELETED_FUNCTION;
@@ -2189,79 +2241,10 @@ private:
   friend class DeclContext;
   friend class DeclarationNameTable;
   void ReleaseDeclContextMaps();
+  void PrintDeclContextMapStats() const;
 
-  /// \brief A \c RecursiveASTVisitor that builds a map from nodes to their
-  /// parents as defined by the \c RecursiveASTVisitor.
-  ///
-  /// Note that the relationship described here is purely in terms of AST
-  /// traversal - there are other relationships (for example declaration context)
-  /// in the AST that are better modeled by special matchers.
-  ///
-  /// FIXME: Currently only builds up the map using \c Stmt and \c Decl nodes.
-  class ParentMapASTVisitor : public RecursiveASTVisitor<ParentMapASTVisitor> {
-  public:
-    /// \brief Builds and returns the translation unit's parent map.
-    ///
-    ///  The caller takes ownership of the returned \c ParentMap.
-    static ParentMap *buildMap(TranslationUnitDecl &TU) {
-      ParentMapASTVisitor Visitor(new ParentMap);
-      Visitor.TraverseDecl(&TU);
-      return Visitor.Parents;
-    }
-
-  private:
-    typedef RecursiveASTVisitor<ParentMapASTVisitor> VisitorBase;
-
-    ParentMapASTVisitor(ParentMap *Parents) : Parents(Parents) {
-    }
-
-    bool shouldVisitTemplateInstantiations() const {
-      return true;
-    }
-    bool shouldVisitImplicitCode() const {
-      return true;
-    }
-    // Disables data recursion. We intercept Traverse* methods in the RAV, which
-    // are not triggered during data recursion.
-    bool shouldUseDataRecursionFor(clang::Stmt *S) const {
-      return false;
-    }
-
-    template <typename T>
-    bool TraverseNode(T *Node, bool(VisitorBase:: *traverse) (T *)) {
-      if (Node == NULL)
-        return true;
-      if (ParentStack.size() > 0)
-        // FIXME: Currently we add the same parent multiple times, for example
-        // when we visit all subexpressions of template instantiations; this is
-        // suboptimal, bug benign: the only way to visit those is with
-        // hasAncestor / hasParent, and those do not create new matches.
-        // The plan is to enable DynTypedNode to be storable in a map or hash
-        // map. The main problem there is to implement hash functions /
-        // comparison operators for all types that DynTypedNode supports that
-        // do not have pointer identity.
-        (*Parents)[Node].push_back(ParentStack.back());
-      ParentStack.push_back(ast_type_traits::DynTypedNode::create(*Node));
-      bool Result = (this ->* traverse) (Node);
-      ParentStack.pop_back();
-      return Result;
-    }
-
-    bool TraverseDecl(Decl *DeclNode) {
-      return TraverseNode(DeclNode, &VisitorBase::TraverseDecl);
-    }
-
-    bool TraverseStmt(Stmt *StmtNode) {
-      return TraverseNode(StmtNode, &VisitorBase::TraverseStmt);
-    }
-
-    ParentMap *Parents;
-    llvm::SmallVector<ast_type_traits::DynTypedNode, 16> ParentStack;
-
-    friend class RecursiveASTVisitor<ParentMapASTVisitor>;
-  };
-
-  llvm::OwningPtr<ParentMap> AllParents;
+  /// \brief The parents of all nodes, computed on demand.
+  llvm::OwningPtr<ParentIndex> AllParents;
 };
 
 /// \brief Utility function for constructing a nullary selector.
@@ -14,11 +14,13 @@
 #ifndef LLVM_CLANG_AST_ASTIMPORTER_H
 #define LLVM_CLANG_AST_ASTIMPORTER_H
 
+#include "clang/AST/DeclHasher.h"
 #include "clang/AST/DeclarationName.h"
 #include "clang/AST/Type.h"
 #include "clang/Basic/SourceLocation.h"
 #include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/DenseSet.h"
+#include "llvm/ADT/OwningPtr.h"
 #include "llvm/ADT/SmallVector.h"
 
 namespace clang {
@@ -31,8 +33,50 @@ namespace clang {
   class IdentifierInfo;
   class NestedNameSpecifier;
   class Stmt;
+  class TagDecl;
   class TypeSourceInfo;
-  
+
+  /// \brief An index of the tag definitions in a context into which several
+  /// ASTs are imported, keyed by their structural hash.
+  ///
+  /// Importers that share an index record every tag definition that they
+  /// import or find to be structurally equivalent to a definition in the
+  /// "to" context. Each definition is recorded under its own structural hash,
+  /// computed in the "to" context. A later importer, typically from another
+  /// AST, that meets a tag with the same structural hash then knows that it
+  /// is equivalent to the recorded definition without comparing the two.
+  class ASTImportIndex {
+  public:
+    typedef std::pair<uint64_t, uint64_t> KeyType;
+
+  private:
+    llvm::DenseMap<KeyType, TagDecl *> Tags;
+
+    /// \brief Computes the structural hashes of the recorded definitions.
+    DeclHasher ToHasher;
+
+  public:
+    explicit ASTImportIndex(ASTContext &ToContext) : ToHasher(ToContext) {}
+
+    /// \brief Returns the definition in the "to" context with the given
+    /// structural hash, or NULL if there is none.
+    TagDecl *lookup(const DeclHash &Hash) const {
+      return Tags.lookup(KeyType(Hash.High, Hash.Low));
+    }
+
+    /// \brief Record the given definition in the "to" context under its
+    /// structural hash, unless it cannot be hashed or another definition
+    /// with the same hash was already recorded.
+    void insert(TagDecl *To) {
+      DeclHash Hash;
+      if (ToHasher.hashStructure(To, Hash))
+        Tags.insert(std::make_pair(KeyType(Hash.High, Hash.Low), To));
+    }
+
+    /// \brief Returns the number of definitions in the index.
+    unsigned size() const { return Tags.size(); }
+  };
+
   /// \brief Imports selected nodes from one AST context into another context,
   /// merging AST nodes where appropriate.
   class ASTImporter {
@@ -75,6 +119,16 @@ namespace clang {
     /// \brief Declaration (from, to) pairs that are known not to be equivalent
     /// (which we have already complained about).
     NonEquivalentDeclSet NonEquivalentDecls;
+
+    /// \brief The index of tag definitions shared with other importers into
+    /// the same context, if any.
+    ASTImportIndex *SharedIndex;
+
+    /// \brief Computes the structural hashes of tags in the "from" context,
+    /// created on first use of the shared index.
+    OwningPtr<DeclHasher> FromHasher;
+
+    bool hashFromTag(TagDecl *From, DeclHash &Hash);
     
   public:
     /// \brief Create a new AST importer.
@@ -99,6 +153,14 @@ namespace clang {
     /// \brief Whether the importer will perform a minimal import, creating
     /// to-be-completed forward declarations when possible.
     bool isMinimalImport() const { return Minimal; }
+
+    /// \brief Share the given index of tag definitions with other importers
+    /// into the same "to" context.
+    void setSharedIndex(ASTImportIndex *Index) { SharedIndex = Index; }
+
+    /// \brief Retrieve the index of tag definitions shared with other
+    /// importers, if any.
+    ASTImportIndex *getSharedIndex() const { return SharedIndex; }
     
     /// \brief Import the given type from the "from" context into the "to"
     /// context.
@@ -276,6 +338,15 @@ namespace clang {
     /// equivalent.
     bool IsStructurallyEquivalent(QualType From, QualType To,
                                   bool Complain = true);
+
+    /// \brief Determine whether the shared index already records that the
+    /// given tag definitions are structurally equivalent.
+    bool isKnownEquivalent(TagDecl *From, TagDecl *To);
+
+    /// \brief Record in the shared index that the given tag definition in the
+    /// "to" context is structurally equivalent to the one in the "from"
+    /// context.
+    void noteEquivalent(TagDecl *From, TagDecl *To);
   };
 }
 
@@ -200,6 +200,9 @@ public:
   
   /// \brief Whether we are finding multiple paths to detect ambiguities.
   bool isFindingAmbiguities() const { return FindAmbiguities; }
+
+  /// \brief Specify whether we should be finding ambiguities or not.
+  void setFindAmbiguities(bool FA) { FindAmbiguities = FA; }
   
   /// \brief Whether we are recording paths.
   bool isRecordingPaths() const { return RecordPaths; }
@@ -229,6 +232,69 @@ public:
   void swap(CXXBasePaths &Other);
 };
 
+/// \brief The set of all direct and indirect base classes of a class
+/// definition, with the number of base class subobjects of each.
+///
+/// A \c CXXBaseSet answers whether a class is derived from another, whether
+/// that base is virtual and whether it is ambiguous, without enumerating the
+/// paths to the base as \c CXXBasePaths does. It is computed once for each
+/// class by \c ASTContext::getCXXBaseSet; the paths themselves only need to
+/// be built to check access or to diagnose an ambiguity.
+class CXXBaseSet {
+public:
+  /// \brief A base class, and how many subobjects of it a class has.
+  struct Entry {
+    /// \brief The canonical declaration of the base class.
+    const CXXRecordDecl *Base;
+
+    /// \brief The number of non-virtual base specifiers naming this base,
+    /// outside of the virtual bases of the class.
+    unsigned NumOwnNonVirtual;
+
+    /// \brief The number of non-virtual subobjects of this base, including
+    /// those within the virtual bases of the class.
+    unsigned NumNonVirtual;
+
+    /// \brief Whether this base is also a virtual base of the class.
+    bool IsVirtual;
+  };
+
+  typedef const Entry *iterator;
+
+private:
+  /// \brief The entries, sorted by the address of the base class.
+  const Entry *Entries;
+  unsigned NumEntries;
+
+public:
+  CXXBaseSet(const Entry *Entries, unsigned NumEntries)
+    : Entries(Entries), NumEntries(NumEntries) { }
+
+  iterator begin() const { return Entries; }
+  iterator end() const { return Entries + NumEntries; }
+  unsigned size() const { return NumEntries; }
+
+  /// \brief Find the entry of the given base class, or return null if it is
+  /// not a base of the class.
+  const Entry *find(const CXXRecordDecl *Base) const;
+
+  /// \brief Determine whether the given class is a direct or indirect base.
+  bool contains(const CXXRecordDecl *Base) const { return find(Base) != 0; }
+
+  /// \brief Determine whether the given class is a virtual base.
+  bool isVirtual(const CXXRecordDecl *Base) const {
+    const Entry *E = find(Base);
+    return E && E->IsVirtual;
+  }
+
+  /// \brief Determine whether the class has more than one subobject of the
+  /// given base class, so that a conversion to it is ambiguous.
+  bool isAmbiguous(const CXXRecordDecl *Base) const {
+    const Entry *E = find(Base);
+    return E && E->NumNonVirtual + (E->IsVirtual ? 1 : 0) > 1;
+  }
+};
+
 /// \brief Uniquely identifies a virtual method within a class
 /// hierarchy by the method itself and a class subobject number.
 struct UniqueVirtualMethod {
@@ -1373,11 +1373,6 @@ private:
   /// no formals.
   ParmVarDecl **ParamInfo;
 
-  /// DeclsInPrototypeScope - Array of pointers to NamedDecls for
-  /// decls defined in the function prototype that are not parameters. E.g.
-  /// 'enum Y' in 'void f(enum Y {AA} x) {}'.
-  ArrayRef<NamedDecl *> DeclsInPrototypeScope;
-
   LazyDeclStmtPtr Body;
 
   // FIXME: This can be packed into the bitfields in Decl.
@@ -1402,6 +1397,12 @@ private:
   /// skipped.
   unsigned HasSkippedBody : 1;
 
+  /// \brief Whether this function declares anything in its prototype scope
+  /// other than its parameters. E.g. 'enum Y' in 'void f(enum Y {AA} x) {}'.
+  ///
+  /// The declarations themselves are kept in a side table of the ASTContext.
+  unsigned HasDeclsInPrototypeScope : 1;
+
   /// \brief End part of this FunctionDecl's source range.
   ///
   /// We could compute the full range in getSourceRange(). However, when we're
@@ -1486,6 +1487,7 @@ protected:
       IsDefaulted(false), IsExplicitlyDefaulted(false),
       HasImplicitReturnZero(false), IsLateTemplateParsed(false),
       IsConstexpr(isConstexprSpecified), HasSkippedBody(false),
+      HasDeclsInPrototypeScope(false),
       EndRangeLoc(NameInfo.getEndLoc()),
       TemplateOrSpecialization(),
       DNLoc(NameInfo.getInfo()) {}
@@ -1759,9 +1761,7 @@ public:
     setParams(getASTContext(), NewParamInfo);
   }
 
-  const ArrayRef<NamedDecl *> &getDeclsInPrototypeScope() const {
-    return DeclsInPrototypeScope;
-  }
+  ArrayRef<NamedDecl *> getDeclsInPrototypeScope() const;
   void setDeclsInPrototypeScope(ArrayRef<NamedDecl *> NewDecls);
 
   /// getMinRequiredArguments - Returns the minimum number of arguments
@@ -215,12 +215,83 @@ class StoredDeclsMap
   : public llvm::SmallDenseMap<DeclarationName, StoredDeclsList, 4> {
 
 public:
+  StoredDeclsMap() : NameFilter(2, 0) {}
+
   static void DestroyAll(StoredDeclsMap *Map, bool Dependent);
 
+  /// \brief Retrieve the list of declarations with the given name, creating
+  /// an empty one if the name is not yet in the map.
+  ///
+  /// All insertions into the map should go through this function (or
+  /// noteName), so that the name filter stays conservative.
+  StoredDeclsList &getOrCreate(DeclarationName Name) {
+    noteName(Name);
+    return (*this)[Name];
+  }
+
+  /// \brief Record that the given name is (or may be) stored in this map.
+  void noteName(DeclarationName Name) {
+    // Keep the filter at BitsPerName bits for each name, so that it does not
+    // saturate as the map grows.
+    if ((size() + 1) * BitsPerName > NameFilter.size() * 64)
+      growNameFilter();
+    setFilterBits(Name);
+  }
+
+  /// \brief Determine whether this map may contain the given name.
+  ///
+  /// The names in the map are summarized by a Bloom filter that grows with
+  /// the map, so a false result means the name is certainly absent and the
+  /// hash table need not be probed. This makes it cheap to skip the many
+  /// contexts visited by unqualified lookup that do not declare the name,
+  /// including the lookups for using-directives performed in every enclosing
+  /// namespace.
+  bool mayContain(DeclarationName Name) const {
+    unsigned Bit1, Bit2;
+    getFilterBits(Name, Bit1, Bit2);
+    return (NameFilter[Bit1 / 64] & (uint64_t(1) << (Bit1 % 64))) &&
+           (NameFilter[Bit2 / 64] & (uint64_t(1) << (Bit2 % 64)));
+  }
+
+  /// \brief Returns the number of bytes of memory used by the name filter
+  /// outside of the map object itself.
+  size_t getNameFilterMemorySize() const {
+    return NameFilter.isSmall() ? 0 : NameFilter.capacity() * sizeof(uint64_t);
+  }
+
 private:
   friend class ASTContext; // walks the chain deleting these
   friend class DeclContext;
   llvm::PointerIntPair<StoredDeclsMap*, 1> Previous;
+
+  /// \brief The number of filter bits per name stored in the map. With two
+  /// bits set per name, about one absent name in twenty passes the filter.
+  static const unsigned BitsPerName = 8;
+
+  /// \brief A Bloom filter over the names stored in this map. The number of
+  /// bits is a power of two, starting at 128.
+  SmallVector<uint64_t, 2> NameFilter;
+
+  /// \brief Double the size of the name filter until it can hold one more
+  /// name, and rebuild it from the names in the map.
+  void growNameFilter();
+
+  void setFilterBits(DeclarationName Name) {
+    unsigned Bit1, Bit2;
+    getFilterBits(Name, Bit1, Bit2);
+    NameFilter[Bit1 / 64] |= uint64_t(1) << (Bit1 % 64);
+    NameFilter[Bit2 / 64] |= uint64_t(1) << (Bit2 % 64);
+  }
+
+  void getFilterBits(DeclarationName Name, unsigned &Bit1,
+                     unsigned &Bit2) const {
+    // Declaration names are uniqued pointers; scramble them with two
+    // multiplicative hashes and take the indices from the high bits.
+    uint64_t Key = uint64_t(Name.getAsOpaqueInteger());
+    unsigned Mask = NameFilter.size() * 64 - 1;
+    Bit1 = unsigned((Key * 0x9E3779B97F4A7C15ULL) >> 32) & Mask;
+    Bit2 = unsigned((Key * 0xC2B2AE3D27D4EB4FULL) >> 32) & Mask;
+  }
 };
 
 class DependentStoredDeclsMap : public StoredDeclsMap {
@@ -0,0 +1,107 @@
+//===--- DeclHasher.h - Stable hashes of declarations -----------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+//  This file defines the DeclHasher class, which computes content-based hashes
+//  of declarations that are the same in every compilation of the same code.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_CLANG_AST_DECLHASHER_H
+#define LLVM_CLANG_AST_DECLHASHER_H
+
+#include "clang/Basic/LLVM.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/Support/DataTypes.h"
+#include <utility>
+
+namespace llvm {
+  class FoldingSetNodeID;
+}
+
+namespace clang {
+  class ASTContext;
+  class Decl;
+  struct PrintingPolicy;
+  class QualType;
+  class TagDecl;
+
+/// \brief A 128-bit hash of a declaration.
+struct DeclHash {
+  uint64_t High;
+  uint64_t Low;
+
+  DeclHash() : High(0), Low(0) {}
+  DeclHash(uint64_t High, uint64_t Low) : High(High), Low(Low) {}
+
+  friend bool operator==(const DeclHash &X, const DeclHash &Y) {
+    return X.High == Y.High && X.Low == Y.Low;
+  }
+  friend bool operator!=(const DeclHash &X, const DeclHash &Y) {
+    return !(X == Y);
+  }
+};
+
+/// \brief Computes hashes of the semantically relevant parts of declarations.
+///
+/// The hash of a declaration covers its kind, qualified name, type,
+/// attributes and specifiers, and the body or initializer of a function or
+/// variable. It does not depend on source locations, on the addresses of AST
+/// nodes, or on the spelling of parameter names, so it is the same in every
+/// compilation of the same code with the same options.
+///
+/// The hash of a declaration does not cover the declarations it refers to: a
+/// client that needs to know whether generated code may change, for example
+/// because a called inline function changed, must combine the hashes of
+/// those declarations itself.
+class DeclHasher {
+  const ASTContext &Context;
+  llvm::DenseMap<const Decl *, DeclHash> Hashes;
+
+  /// \brief The structural hashes of tag declarations, or false for those
+  /// that reach a type that cannot be hashed structurally.
+  llvm::DenseMap<const TagDecl *, std::pair<bool, DeclHash> > StructureHashes;
+
+  void profileDecl(const Decl *D, llvm::FoldingSetNodeID &ID,
+                   bool IncludeBody);
+
+public:
+  explicit DeclHasher(const ASTContext &Context) : Context(Context) {}
+
+  /// \brief Compute the hash of the given declaration.
+  DeclHash hash(const Decl *D);
+
+  /// \brief Retrieve the printing policy used for the spellings in hashes,
+  /// which prints anonymous tags and lambdas without their location.
+  static PrintingPolicy getStablePrintingPolicy(const ASTContext &Context);
+
+  /// \brief Add the given type to a stable profile.
+  ///
+  /// Types are identified by their canonical spelling. Unnamed tags print
+  /// the same, so each is also identified by its position among the unnamed
+  /// tags of its context, and each closure type by its captures and call
+  /// operator, rather than by its source location.
+  static void profileType(const ASTContext &Context, QualType T,
+                          llvm::FoldingSetNodeID &ID);
+
+  /// \brief Compute a hash of the given tag declaration that also covers the
+  /// definitions of all the tags reachable from the types of its fields and
+  /// bases.
+  ///
+  /// Two tags with the same structural hash are structurally equivalent, so
+  /// that a client merging declarations from several contexts can match them
+  /// by hash alone.
+  ///
+  /// \returns false if a reachable type cannot be hashed structurally, for
+  /// example because it is dependent or an Objective-C type.
+  bool hashStructure(const TagDecl *D, DeclHash &Hash);
+};
+
+} // end namespace clang
+
+#endif
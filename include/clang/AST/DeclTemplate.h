@@ -743,7 +743,7 @@ protected:
   /// \brief Data that is common to all of the declarations of a given
   /// function template.
   struct Common : CommonBase {
-    Common() : InjectedArgs(0) { }
+    Common() : InjectedArgs(0), CallParamShapes(0) { }
 
     /// \brief The function template specializations for this function
     /// template, including explicit specializations and instantiations.
@@ -757,6 +757,14 @@ protected:
     /// template, and is allocated lazily, since most function templates do not
     /// require the use of this information.
     TemplateArgument *InjectedArgs;
+
+    /// \brief The shape of each of the parameters of the templated function,
+    /// as far as template argument deduction from a call is concerned.
+    ///
+    /// This pointer refers to one CallParamShape per function parameter, and
+    /// is allocated lazily the first time the function template is named in
+    /// a call.
+    unsigned char *CallParamShapes;
   };
 
   FunctionTemplateDecl(DeclContext *DC, SourceLocation L, DeclarationName Name,
@@ -849,6 +857,36 @@ public:
   /// template.
   std::pair<const TemplateArgument *, unsigned> getInjectedTemplateArgs();
 
+  /// \brief The shape of a function parameter's type, as far as template
+  /// argument deduction from a call is concerned.
+  enum CallParamShape {
+    /// \brief Deduction must match the parameter type against the argument
+    /// type in full generality.
+    CPS_General,
+    /// \brief The parameter type contains no template parameters that can
+    /// be deduced, so the argument does not participate in deduction.
+    CPS_NonDeduced,
+    /// \brief The parameter type is "cv T", for a template type parameter T
+    /// of this function template that is not a parameter pack.
+    CPS_TypeParm,
+    /// \brief The parameter type is "cv T&", for a template type parameter T
+    /// of this function template that is not a parameter pack.
+    CPS_LValueRefToTypeParm
+  };
+
+  /// \brief Retrieve the shapes of the function parameters of this function
+  /// template, one CallParamShape per parameter, or NULL if they have not
+  /// been computed.
+  const unsigned char *getCallParamShapes() const {
+    return getCommonPtr()->CallParamShapes;
+  }
+
+  /// \brief Set the shapes of the function parameters of this function
+  /// template, which must be allocated in the ASTContext.
+  void setCallParamShapes(unsigned char *Shapes) {
+    getCommonPtr()->CallParamShapes = Shapes;
+  }
+
   /// \brief Create a function template node.
   static FunctionTemplateDecl *Create(ASTContext &C, DeclContext *DC,
                                       SourceLocation L,
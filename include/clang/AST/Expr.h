@@ -2276,10 +2276,6 @@ class MemberExpr : public Expr {
   /// In X.F, this is the decl referenced by F.
   ValueDecl *MemberDecl;
 
-  /// MemberDNLoc - Provides source/type location info for the
-  /// declaration name embedded in MemberDecl.
-  DeclarationNameLoc MemberDNLoc;
-
   /// MemberLoc - This is the location of the member name.
   SourceLocation MemberLoc;
 
@@ -2305,10 +2301,35 @@ class MemberExpr : public Expr {
   /// was resolved from an overloaded set having size greater than 1.
   bool HadMultipleCandidates : 1;
 
+  /// \brief True if the member name is the name of a constructor,
+  /// destructor, conversion function or operator. When true, the
+  /// DeclarationNameLoc that provides source/type location info for the
+  /// name is allocated immediately after the MemberExpr.
+  bool HasMemberDNLoc : 1;
+
+  /// \brief Retrieve the source/type location info for the member name.
+  DeclarationNameLoc *getMemberDNLoc() {
+    assert(HasMemberDNLoc);
+    return reinterpret_cast<DeclarationNameLoc *> (this + 1);
+  }
+
+  /// \brief Retrieve the source/type location info for the member name.
+  const DeclarationNameLoc *getMemberDNLoc() const {
+    return const_cast<MemberExpr *>(this)->getMemberDNLoc();
+  }
+
+  /// \brief Retrieve the start of the data that follows the optional
+  /// DeclarationNameLoc.
+  void *getTrailingData() {
+    if (HasMemberDNLoc)
+      return getMemberDNLoc() + 1;
+    return this + 1;
+  }
+
   /// \brief Retrieve the qualifier that preceded the member name, if any.
   MemberNameQualifier *getMemberQualifier() {
     assert(HasQualifierOrFoundDecl);
-    return reinterpret_cast<MemberNameQualifier *> (this + 1);
+    return reinterpret_cast<MemberNameQualifier *> (getTrailingData());
   }
 
   /// \brief Retrieve the qualifier that preceded the member name, if any.
@@ -2317,25 +2338,11 @@ class MemberExpr : public Expr {
   }
 
 public:
-  MemberExpr(Expr *base, bool isarrow, ValueDecl *memberdecl,
-             const DeclarationNameInfo &NameInfo, QualType ty,
-             ExprValueKind VK, ExprObjectKind OK)
-    : Expr(MemberExprClass, ty, VK, OK,
-           base->isTypeDependent(),
-           base->isValueDependent(),
-           base->isInstantiationDependent(),
-           base->containsUnexpandedParameterPack()),
-      Base(base), MemberDecl(memberdecl), MemberDNLoc(NameInfo.getInfo()),
-      MemberLoc(NameInfo.getLoc()), IsArrow(isarrow),
-      HasQualifierOrFoundDecl(false), HasTemplateKWAndArgsInfo(false),
-      HadMultipleCandidates(false) {
-    assert(memberdecl->getDeclName() == NameInfo.getName());
-  }
-
   // NOTE: this constructor should be used only when it is known that
   // the member name can not provide additional syntactic info
   // (i.e., source locations for C++ operator names or type source info
-  // for constructors, destructors and conversion operators).
+  // for constructors, destructors and conversion operators). Otherwise,
+  // use MemberExpr::Create.
   MemberExpr(Expr *base, bool isarrow, ValueDecl *memberdecl,
              SourceLocation l, QualType ty,
              ExprValueKind VK, ExprObjectKind OK)
@@ -2343,10 +2350,10 @@ public:
            base->isTypeDependent(), base->isValueDependent(),
            base->isInstantiationDependent(),
            base->containsUnexpandedParameterPack()),
-      Base(base), MemberDecl(memberdecl), MemberDNLoc(), MemberLoc(l),
+      Base(base), MemberDecl(memberdecl), MemberLoc(l),
       IsArrow(isarrow),
       HasQualifierOrFoundDecl(false), HasTemplateKWAndArgsInfo(false),
-      HadMultipleCandidates(false) {}
+      HadMultipleCandidates(false), HasMemberDNLoc(false) {}
 
   static MemberExpr *Create(ASTContext &C, Expr *base, bool isarrow,
                             NestedNameSpecifierLoc QualifierLoc,
@@ -2405,7 +2412,7 @@ public:
       return 0;
 
     if (!HasQualifierOrFoundDecl)
-      return reinterpret_cast<ASTTemplateKWAndArgsInfo *>(this + 1);
+      return reinterpret_cast<ASTTemplateKWAndArgsInfo *>(getTrailingData());
 
     return reinterpret_cast<ASTTemplateKWAndArgsInfo *>(
                                                       getMemberQualifier() + 1);
@@ -2494,8 +2501,10 @@ public:
 
   /// \brief Retrieve the member declaration name info.
   DeclarationNameInfo getMemberNameInfo() const {
+    if (!HasMemberDNLoc)
+      return DeclarationNameInfo(MemberDecl->getDeclName(), MemberLoc);
     return DeclarationNameInfo(MemberDecl->getDeclName(),
-                               MemberLoc, MemberDNLoc);
+                               MemberLoc, *getMemberDNLoc());
   }
 
   bool isArrow() const { return IsArrow; }
@@ -22,6 +22,7 @@ namespace clang {
 
 class ASTConsumer;
 class CXXBaseSpecifier;
+class CXXRecordDecl;
 class DeclarationName;
 class ExternalSemaSource; // layering violation required for downcasting
 class FieldDecl;
@@ -31,6 +32,7 @@ class RecordDecl;
 class Selector;
 class Stmt;
 class TagDecl;
+struct VTableLayoutInfo;
 
 /// \brief Enumeration describing the result of loading information from
 /// an external source.
@@ -252,6 +254,23 @@ public:
   { 
     return false;
   }
+
+  /// \brief Provide the vtable related information of the given class.
+  ///
+  /// This routine allows the external AST source to provide the layout of
+  /// the vtable group of a class, along with the thunks and virtual base
+  /// offset offsets that go with it, for example because they were computed
+  /// when the class was written to an AST file. The information must be
+  /// exactly what the vtable builder would compute for the class.
+  ///
+  /// \param RD The dynamic class whose vtable layout is being requested.
+  ///
+  /// \param Info Receives the vtable related information of the class.
+  ///
+  /// \returns true if the vtable layout was provided, false otherwise.
+  virtual bool layoutVTable(const CXXRecordDecl *RD, VTableLayoutInfo &Info) {
+    return false;
+  }
   
   //===--------------------------------------------------------------------===//
   // Queries for performance analysis.
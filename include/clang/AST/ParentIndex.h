@@ -0,0 +1,106 @@
+//===--- ParentIndex.h - Parents of all nodes in a translation unit -*- C++ -*-//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+//  This file defines the ParentIndex class, which records the parents of all
+//  declarations and statements of a translation unit.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_CLANG_AST_PARENTINDEX_H
+#define LLVM_CLANG_AST_PARENTINDEX_H
+
+#include "clang/AST/ASTTypeTraits.h"
+#include "clang/Basic/LLVM.h"
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/DenseMap.h"
+#include <vector>
+
+namespace clang {
+  class TranslationUnitDecl;
+
+/// \brief The parents of all \c Decl and \c Stmt nodes of a translation unit,
+/// as defined by the \c RecursiveASTVisitor.
+///
+/// Each node is assigned a dense ID, in the order in which the traversal
+/// first reaches it. The parents of all nodes are stored as IDs in a single
+/// flat array, so that once the ID of a node is known, walking up to any of
+/// its ancestors only indexes into arrays. Only the translation from a node
+/// to its ID requires a hash lookup.
+///
+/// A node has several parents when it is reached along several paths, for
+/// example a statement in a class template that is also visited as part of
+/// each of its instantiations. Each distinct parent is recorded once.
+class ParentIndex {
+public:
+  typedef unsigned NodeID;
+
+  /// \brief The ID returned for nodes that are not in the index.
+  static const NodeID InvalidNodeID = ~0U;
+
+private:
+  /// \brief Maps the memoization data of each node to its ID.
+  llvm::DenseMap<const void *, NodeID> IDs;
+
+  /// \brief The nodes, indexed by ID.
+  std::vector<ast_type_traits::DynTypedNode> Nodes;
+
+  /// \brief The parents of the node with ID \c I are
+  /// Parents[ParentStart[I], ParentStart[I + 1]).
+  std::vector<unsigned> ParentStart;
+
+  /// \brief The IDs of the parents of all nodes.
+  std::vector<NodeID> Parents;
+
+  ParentIndex() {}
+  ParentIndex(const ParentIndex &) LLVM_DELETED_FUNCTION;
+  void operator=(const ParentIndex &) LLVM_DELETED_FUNCTION;
+
+  friend class ParentIndexBuilder;
+
+public:
+  /// \brief Builds the index over the given translation unit.
+  ///
+  /// The caller takes ownership of the returned \c ParentIndex.
+  static ParentIndex *build(TranslationUnitDecl &TU);
+
+  /// \brief Returns the ID of the given node, or \c InvalidNodeID if the node
+  /// is not in the index.
+  NodeID getNodeID(const ast_type_traits::DynTypedNode &Node) const {
+    llvm::DenseMap<const void *, NodeID>::const_iterator I
+      = IDs.find(Node.getMemoizationData());
+    if (I == IDs.end())
+      return InvalidNodeID;
+    return I->second;
+  }
+
+  /// \brief Returns the node with the given ID.
+  const ast_type_traits::DynTypedNode &getNode(NodeID ID) const {
+    assert(ID < Nodes.size() && "Invalid node ID");
+    return Nodes[ID];
+  }
+
+  /// \brief Returns the IDs of the parents of the node with the given ID.
+  ArrayRef<NodeID> getParentIDs(NodeID ID) const {
+    assert(ID < Nodes.size() && "Invalid node ID");
+    unsigned Begin = ParentStart[ID], End = ParentStart[ID + 1];
+    if (Begin == End)
+      return ArrayRef<NodeID>();
+    return ArrayRef<NodeID>(&Parents[Begin], End - Begin);
+  }
+
+  /// \brief Returns the number of nodes in the index.
+  unsigned size() const { return Nodes.size(); }
+
+  /// \brief Returns the number of bytes of memory used by the index.
+  size_t getMemorySize() const;
+};
+
+} // end namespace clang
+
+#endif
@@ -438,6 +438,15 @@ public:
   /// written in the source.
   void Profile(llvm::FoldingSetNodeID &ID, const ASTContext &Context,
                bool Canonical) const;
+
+  /// \brief Produce a representation of the given statement which, unlike
+  /// the one produced by Profile(), does not depend on the addresses of the
+  /// declarations, types and names it refers to.
+  ///
+  /// The result is the same in every compilation of the same code, and
+  /// does not depend on source locations.
+  void ProfileStable(llvm::FoldingSetNodeID &ID,
+                     const ASTContext &Context) const;
 };
 
 /// DeclStmt - Adaptor class for mixing declarations with statements and
@@ -2824,6 +2824,9 @@ private:
   /// This is a value of type \c RefQualifierKind.
   unsigned RefQualifier : 2;
 
+  /// \brief The hash of the profile under which this type was uniqued.
+  unsigned ProfileHash;
+
   // ArgInfo - There is an variable size array after the class in memory that
   // holds the argument types.
 
@@ -3015,6 +3018,10 @@ public:
   }
 
   void Profile(llvm::FoldingSetNodeID &ID, const ASTContext &Ctx);
+
+  /// \brief Retrieve the hash of the profile under which this type was
+  /// uniqued.
+  unsigned getProfileHash() const { return ProfileHash; }
   static void Profile(llvm::FoldingSetNodeID &ID, QualType Result,
                       arg_type_iterator ArgTys, unsigned NumArgs,
                       const ExtProtoInfo &EPI, const ASTContext &Context);
@@ -3624,6 +3631,10 @@ class TemplateSpecializationType
   /// \brief Whether this template specialization type is a substituted
   /// type alias.
   bool TypeAlias : 1;
+
+  /// \brief The hash of the profile under which this type was uniqued, if it
+  /// is canonical.
+  unsigned ProfileHash;
     
   TemplateSpecializationType(TemplateName T,
                              const TemplateArgument *Args,
@@ -3724,6 +3735,10 @@ public:
       getAliasedType().Profile(ID);
   }
 
+  /// \brief Retrieve the hash of the profile under which this type was
+  /// uniqued, if it is canonical.
+  unsigned getProfileHash() const { return ProfileHash; }
+
   static void Profile(llvm::FoldingSetNodeID &ID, TemplateName T,
                       const TemplateArgument *Args,
                       unsigned NumArgs,
@@ -5125,4 +5140,43 @@ inline const ArrayType *Type::castAsArrayTypeUnsafe() const {
 
 }  // end namespace clang
 
+namespace llvm {
+
+/// \brief Function prototypes and template specializations remember the hash
+/// of the profile under which they were uniqued. Lookups in their uniquing
+/// tables use it to reject other types in the same bucket without recomputing
+/// their profiles, which are long for types with many arguments, and the
+/// tables reuse it when they grow.
+template<>
+struct ContextualFoldingSetTrait< ::clang::FunctionProtoType,
+                                  ::clang::ASTContext&>
+  : DefaultContextualFoldingSetTrait< ::clang::FunctionProtoType,
+                                      ::clang::ASTContext&> {
+  static bool Equals(::clang::FunctionProtoType &X, const FoldingSetNodeID &ID,
+                     unsigned IDHash, FoldingSetNodeID &TempID,
+                     ::clang::ASTContext &Context);
+  static unsigned ComputeHash(::clang::FunctionProtoType &X,
+                              FoldingSetNodeID &TempID,
+                              ::clang::ASTContext &Context) {
+    return X.getProfileHash();
+  }
+};
+
+template<>
+struct ContextualFoldingSetTrait< ::clang::TemplateSpecializationType,
+                                  ::clang::ASTContext&>
+  : DefaultContextualFoldingSetTrait< ::clang::TemplateSpecializationType,
+                                      ::clang::ASTContext&> {
+  static bool Equals(::clang::TemplateSpecializationType &X,
+                     const FoldingSetNodeID &ID, unsigned IDHash,
+                     FoldingSetNodeID &TempID, ::clang::ASTContext &Context);
+  static unsigned ComputeHash(::clang::TemplateSpecializationType &X,
+                              FoldingSetNodeID &TempID,
+                              ::clang::ASTContext &Context) {
+    return X.getProfileHash();
+  }
+};
+
+}  // end namespace llvm
+
 #endif
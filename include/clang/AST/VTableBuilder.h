@@ -266,6 +266,30 @@ public:
   }
 };
 
+/// VTableLayoutInfo - All the vtable related information of a class: the
+/// layout of its vtable group, together with the thunks and vbase offset
+/// offsets that are computed along with it. This is what an external AST
+/// source needs to provide in order to replace the vtable builder.
+struct VTableLayoutInfo {
+  /// Components - The components of the vtable group.
+  SmallVector<VTableComponent, 64> Components;
+
+  /// VTableThunks - The thunks needed by the vtable group, sorted by index.
+  SmallVector<VTableLayout::VTableThunkTy, 1> VTableThunks;
+
+  /// AddressPoints - The address points of all vtables in the group.
+  VTableLayout::AddressPointsMapTy AddressPoints;
+
+  /// Thunks - The thunks that each method of the class needs.
+  SmallVector<std::pair<const CXXMethodDecl *,
+                        VTableLayout::ThunkInfoVectorTy>, 4> Thunks;
+
+  /// VBaseOffsetOffsets - The vtable offset (relative to the address point)
+  /// in chars where the offset of each virtual base of the class is stored.
+  SmallVector<std::pair<const CXXRecordDecl *, CharUnits>, 4>
+    VBaseOffsetOffsets;
+};
+
 class VTableContext {
   ASTContext &Context;
 
@@ -312,6 +336,13 @@ private:
   /// given record decl.
   void ComputeVTableRelatedInformation(const CXXRecordDecl *RD);
 
+  /// ComputeSingleInheritanceVTableLayout - Compute the vtable related
+  /// information for a class whose bases form a chain of primary bases
+  /// without any virtual bases, directly from the vtable indices of its
+  /// methods. Returns false if the class needs the full vtable builder.
+  bool ComputeSingleInheritanceVTableLayout(const CXXRecordDecl *RD,
+                                            VTableLayoutInfo &Info);
+
   /// ErrorUnsupported - Print out an error that the v-table layout code
   /// doesn't support the particular C++ feature yet.
   void ErrorUnsupported(StringRef Feature, SourceLocation Location);
@@ -334,6 +365,11 @@ public:
     return *VTableLayouts[RD];
   }
 
+  /// computeVTableLayoutInfo - Compute all vtable related information for the
+  /// given record decl, without storing it in this context.
+  void computeVTableLayoutInfo(const CXXRecordDecl *RD,
+                               VTableLayoutInfo &Info);
+
   VTableLayout *
   createConstructionVTableLayout(const CXXRecordDecl *MostDerivedClass,
                                  CharUnits MostDerivedClassOffset,
@@ -20,6 +20,7 @@
 #define LLVM_CLANG_FORMAT_H
 
 #include "clang/AST/CanonicalType.h"
+#include <vector>
 
 namespace clang {
 
@@ -640,6 +641,98 @@ bool ParseScanfString(FormatStringHandler &H,
                       const char *beg, const char *end, const LangOptions &LO,
                       const TargetInfo &Target);
 
+/// \brief The handler callbacks produced by parsing a format string, which
+/// can be replayed to other handlers without parsing the string again.
+///
+/// The positions passed to the callbacks point into the string that was
+/// parsed, so that string must outlive this object, and a handler that
+/// computes offsets must use getBegin() as the start of the string.
+class RecordedFormatString : public FormatStringHandler {
+  enum EventKind {
+    EK_NullChar,
+    EK_Position,
+    EK_InvalidPosition,
+    EK_ZeroPosition,
+    EK_IncompleteSpecifier,
+    EK_InvalidPrintfConversionSpecifier,
+    EK_PrintfSpecifier,
+    EK_InvalidScanfConversionSpecifier,
+    EK_ScanfSpecifier,
+    EK_IncompleteScanList
+  };
+
+  struct Event {
+    EventKind Kind;
+    const char *Start;
+    /// \brief The length of the text, or the end of an incomplete scan list.
+    union {
+      unsigned Len;
+      const char *End;
+    };
+    /// \brief The position context, or the index of the specifier.
+    unsigned Data;
+  };
+
+  const char *Beg;
+  std::vector<Event> Events;
+  std::vector<analyze_printf::PrintfSpecifier> PrintfSpecifiers;
+  std::vector<analyze_scanf::ScanfSpecifier> ScanfSpecifiers;
+  bool Stopped;
+
+  void addEvent(EventKind Kind, const char *Start, unsigned Len,
+                unsigned Data = 0) {
+    Event E;
+    E.Kind = Kind;
+    E.Start = Start;
+    E.Len = Len;
+    E.Data = Data;
+    Events.push_back(E);
+  }
+
+public:
+  RecordedFormatString() : Beg(0), Stopped(false) {}
+
+  /// \brief Parse the given printf format string, recording the callbacks.
+  void parsePrintf(const char *beg, const char *end, const LangOptions &LO,
+                   const TargetInfo &Target);
+
+  /// \brief Parse the given scanf format string, recording the callbacks.
+  void parseScanf(const char *beg, const char *end, const LangOptions &LO,
+                  const TargetInfo &Target);
+
+  /// \brief The start of the string that was parsed.
+  const char *getBegin() const { return Beg; }
+
+  /// \brief Replay the recorded callbacks to the given handler.
+  ///
+  /// \returns the value that ParsePrintfString or ParseScanfString would
+  /// have returned when parsing the string with that handler.
+  bool replay(FormatStringHandler &H) const;
+
+  virtual void HandleNullChar(const char *nullCharacter);
+  virtual void HandlePosition(const char *startPos, unsigned posLen);
+  virtual void HandleInvalidPosition(const char *startPos, unsigned posLen,
+                                     PositionContext p);
+  virtual void HandleZeroPosition(const char *startPos, unsigned posLen);
+  virtual void HandleIncompleteSpecifier(const char *startSpecifier,
+                                         unsigned specifierLen);
+  virtual bool HandleInvalidPrintfConversionSpecifier(
+                                      const analyze_printf::PrintfSpecifier &FS,
+                                      const char *startSpecifier,
+                                      unsigned specifierLen);
+  virtual bool HandlePrintfSpecifier(const analyze_printf::PrintfSpecifier &FS,
+                                     const char *startSpecifier,
+                                     unsigned specifierLen);
+  virtual bool HandleInvalidScanfConversionSpecifier(
+                                        const analyze_scanf::ScanfSpecifier &FS,
+                                        const char *startSpecifier,
+                                        unsigned specifierLen);
+  virtual bool HandleScanfSpecifier(const analyze_scanf::ScanfSpecifier &FS,
+                                    const char *startSpecifier,
+                                    unsigned specifierLen);
+  virtual void HandleIncompleteScanList(const char *start, const char *end);
+};
+
 } // end analyze_format_string namespace
 } // end clang namespace
 #endif
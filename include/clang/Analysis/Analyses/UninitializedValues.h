@@ -94,6 +94,11 @@ public:
   virtual void handleSelfInit(const VarDecl *vd) {}
 };
 
+/// \brief Determine whether the given declaration context has any variables
+/// that the uninitialized values analysis would track. This only looks at
+/// the declarations, so it is much cheaper than building a CFG.
+bool hasTrackedVariables(const DeclContext &dc);
+
 struct UninitVariablesAnalysisStats {
   unsigned NumVariablesAnalyzed;
   unsigned NumBlockVisits;
@@ -0,0 +1,66 @@
+//===--- MemoryReport.h - Memory usage breakdown ----------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// \brief Defines the clang::MemoryReport class, which collects the memory
+/// used by the components of a translation unit.
+///
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_CLANG_BASIC_MEMORYREPORT_H
+#define LLVM_CLANG_BASIC_MEMORYREPORT_H
+
+#include "clang/Basic/LLVM.h"
+#include "llvm/ADT/StringRef.h"
+#include "llvm/Support/DataTypes.h"
+#include <string>
+#include <vector>
+
+namespace clang {
+
+/// \brief A breakdown of the memory used by a translation unit.
+///
+/// Each component adds entries to the report under one or more categories,
+/// such as "Decls" or "SourceManager". An entry names what it measures, how
+/// many objects of that kind there are (zero if counting makes no sense), and
+/// how many bytes they take.
+///
+/// Entries within a category do not overlap, but categories can: the bytes of
+/// the "Decls", "Stmts" and "Types" categories are allocated from the arena
+/// reported under "ASTContext", for example.
+class MemoryReport {
+public:
+  struct Entry {
+    std::string Category;
+    std::string Name;
+    uint64_t Count;
+    uint64_t Bytes;
+  };
+
+private:
+  std::vector<Entry> Entries;
+
+public:
+  /// \brief Add an entry to the report.
+  void add(StringRef Category, StringRef Name, uint64_t Count, uint64_t Bytes);
+
+  const std::vector<Entry> &getEntries() const { return Entries; }
+
+  /// \brief Returns the total number of bytes of the entries in the given
+  /// category.
+  uint64_t getCategoryBytes(StringRef Category) const;
+
+  /// \brief Write the report as a JSON document, grouping the entries by
+  /// category in the order in which the categories were first used.
+  void writeJSON(raw_ostream &OS) const;
+};
+
+} // end namespace clang
+
+#endif
@@ -59,6 +59,7 @@ class SourceManager;
 class FileManager;
 class FileEntry;
 class LineTableInfo;
+class MemoryReport;
 class LangOptions;
 class ASTWriter;
 class ASTReader;
@@ -1358,6 +1359,10 @@ public:
   /// data structures in the SourceManager.
   size_t getDataStructureSizes() const;
 
+  /// \brief Add the memory used by the SourceManager to the given report,
+  /// under the "SourceManager" category.
+  void reportMemoryUsage(MemoryReport &Report) const;
+
   //===--------------------------------------------------------------------===//
   // Other miscellaneous methods.
   //===--------------------------------------------------------------------===//
@@ -24,15 +24,33 @@ namespace llvm {
 
 namespace clang {
   class DiagnosticsEngine;
+  class FunctionDecl;
   class LangOptions;
   class CodeGenOptions;
   class TargetOptions;
 
+  /// CodeGenDeclFilter - Decides which function definitions are emitted, so
+  /// that a build cache can skip the functions whose code it already has,
+  /// for instance because their DeclHasher hash did not change.
+  class CodeGenDeclFilter {
+  public:
+    virtual ~CodeGenDeclFilter();
+
+    /// shouldEmitFunction - Determine whether to emit the given top-level
+    /// definition of a non-inline function with external linkage. Functions
+    /// that are skipped are referenced through external declarations.
+    virtual bool shouldEmitFunction(const FunctionDecl *FD) = 0;
+  };
+
   class CodeGenerator : public ASTConsumer {
     virtual void anchor();
   public:
     virtual llvm::Module* GetModule() = 0;
     virtual llvm::Module* ReleaseModule() = 0;
+
+    /// setDeclFilter - Set the filter that decides which function
+    /// definitions are emitted. The filter is not owned by the generator.
+    virtual void setDeclFilter(CodeGenDeclFilter *Filter) = 0;
   };
 
   /// CreateLLVMCodeGen - Create a CodeGenerator instance.
@@ -318,6 +318,13 @@ public:
   llvm::StringMap<unsigned> &getCachedCompletionTypes() { 
     return CachedCompletionTypes; 
   }
+
+  /// \brief Retrieve the cached results of member access code completions,
+  /// keyed by the context in which the completion was performed.
+  llvm::StringMap<std::vector<CachedCodeCompletionResult> > &
+  getCachedMemberCompletionResults() {
+    return CachedMemberCompletionResults;
+  }
   
   /// \brief Retrieve the allocator used to cache global code completions.
   IntrusiveRefCntPtr<GlobalCodeCompletionAllocator>
@@ -345,6 +352,16 @@ private:
   /// \brief A mapping from the formatted type name to a unique number for that
   /// type, which is used for type equality comparisons.
   llvm::StringMap<unsigned> CachedCompletionTypes;
+
+  /// \brief The results of member access code completions on classes that
+  /// are defined in the precompiled preamble.
+  ///
+  /// The members of such a class cannot change without rebuilding the
+  /// preamble, so these results are reused by later completions in the same
+  /// context until the preamble is rebuilt. They are allocated by
+  /// \c CachedCompletionAllocator.
+  llvm::StringMap<std::vector<CachedCodeCompletionResult> >
+    CachedMemberCompletionResults;
   
   /// \brief A string hash of the top-level declaration and macro definition 
   /// names processed the last time that we reparsed the file.
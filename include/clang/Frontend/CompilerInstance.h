@@ -40,6 +40,7 @@ class ExternalASTSource;
 class FileEntry;
 class FileManager;
 class FrontendAction;
+class MemoryReport;
 class Module;
 class Preprocessor;
 class Sema;
@@ -428,6 +429,15 @@ public:
 
   ASTReader *getModuleManager() const { return ModuleManager; }
 
+  /// }
+  /// @name Memory Usage
+  /// {
+
+  /// \brief Add the memory used by the source manager, preprocessor, AST
+  /// context, semantic analysis and AST reader of this instance, whichever
+  /// exist, to the given report.
+  void reportMemoryUsage(MemoryReport &Report) const;
+
   /// }
   /// @name Code Completion
   /// {
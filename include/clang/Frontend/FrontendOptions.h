@@ -175,6 +175,14 @@ public:
   /// If given, filter dumped AST Decl nodes by this substring.
   std::string ASTDumpFilter;
 
+  /// If given, the file to which a trace of template instantiation, overload
+  /// resolution and constant evaluation times is written.
+  std::string TimeTraceFile;
+
+  /// If given, the file to which a report of the memory used by the AST and
+  /// the compiler's tables is written.
+  std::string MemoryReportFile;
+
   /// If given, enable code completion at the provided location.
   ParsedSourceLocation CodeCompletionAt;
 
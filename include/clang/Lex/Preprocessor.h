@@ -54,6 +54,7 @@ class PPCallbacks;
 class CodeCompletionHandler;
 class DirectoryLookup;
 class PreprocessingRecord;
+class MemoryReport;
 class ModuleLoader;
 class PreprocessorOptions;
 
@@ -1107,6 +1108,10 @@ public:
 
   size_t getTotalMemory() const;
 
+  /// \brief Add the memory used by the preprocessor, its macros and its
+  /// identifier table to the given report.
+  void reportMemoryUsage(MemoryReport &Report) const;
+
   /// HandleMicrosoftCommentPaste - When the macro expander pastes together a
   /// comment (/##/) in microsoft mode, this method handles updating the current
   /// state, returning the token on the next source line.
@@ -84,6 +84,14 @@ private:
   /// a single function.
   unsigned MaxUninitAnalysisBlockVisitsPerFunction;
 
+  /// \brief Number of functions that skipped uninitialized use analysis
+  /// because they have no variables it tracks.
+  unsigned NumUninitAnalysisSkipped;
+
+  /// \brief Number of functions that skipped thread safety analysis because
+  /// no thread safety attributes have been seen.
+  unsigned NumThreadSafetyAnalysisSkipped;
+
   /// @}
 
 public:
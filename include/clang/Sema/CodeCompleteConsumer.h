@@ -930,6 +930,17 @@ public:
 
   /// \name Code-completion callbacks
   //@{
+  /// \brief Determine whether the consumer already holds the results of a
+  /// member access code completion in the given context.
+  ///
+  /// If so, semantic analysis does not look for the members of the base
+  /// type, and passes no results to ProcessCodeCompleteResults, which is
+  /// expected to supply the cached results instead.
+  virtual bool hasCachedMemberResults(Sema &S,
+                                      const CodeCompletionContext &Context) {
+    return false;
+  }
+
   /// \brief Process the finalized code-completion results.
   virtual void ProcessCodeCompleteResults(Sema &S,
                                           CodeCompletionContext Context,
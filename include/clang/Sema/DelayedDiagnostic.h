@@ -22,6 +22,8 @@
 #define LLVM_CLANG_SEMA_DELAYED_DIAGNOSTIC_H
 
 #include "clang/Sema/Sema.h"
+#include <cstddef>
+#include <iterator>
 
 namespace clang {
 namespace sema {
@@ -226,48 +228,113 @@ private:
 
 /// DelayedDiagnosticPool - A collection of diagnostics which were
 /// delayed.
+///
+/// The diagnostics are kept in a linked list of fixed-size segments, so
+/// that stealing the diagnostics of another pool takes constant time.
 class DelayedDiagnosticPool {
+  enum { SegmentSize = 8 };
+
+  struct Segment {
+    Segment *Next;
+    unsigned Size;
+    DelayedDiagnostic Diagnostics[SegmentSize];
+  };
+
   const DelayedDiagnosticPool *Parent;
-  SmallVector<DelayedDiagnostic, 4> Diagnostics;
+  Segment *Head;
+  Segment *Tail;
 
   DelayedDiagnosticPool(const DelayedDiagnosticPool &) LLVM_DELETED_FUNCTION;
   void operator=(const DelayedDiagnosticPool &) LLVM_DELETED_FUNCTION;
 public:
-  DelayedDiagnosticPool(const DelayedDiagnosticPool *parent) : Parent(parent) {}
+  DelayedDiagnosticPool(const DelayedDiagnosticPool *parent)
+    : Parent(parent), Head(0), Tail(0) {}
   ~DelayedDiagnosticPool() {
-    for (SmallVectorImpl<DelayedDiagnostic>::iterator
-           i = Diagnostics.begin(), e = Diagnostics.end(); i != e; ++i)
-      i->Destroy();
+    while (Segment *Seg = Head) {
+      for (unsigned I = 0; I != Seg->Size; ++I)
+        Seg->Diagnostics[I].Destroy();
+      Head = Seg->Next;
+      delete Seg;
+    }
   }
 
   const DelayedDiagnosticPool *getParent() const { return Parent; }
 
   /// Does this pool, or any of its ancestors, contain any diagnostics?
   bool empty() const {
-    return (Diagnostics.empty() && (Parent == NULL || Parent->empty()));
+    return (pool_empty() && (Parent == NULL || Parent->empty()));
   }
 
   /// Add a diagnostic to this pool.
   void add(const DelayedDiagnostic &diag) {
-    Diagnostics.push_back(diag);
+    if (!Tail || Tail->Size == SegmentSize) {
+      Segment *Seg = new Segment;
+      Seg->Next = 0;
+      Seg->Size = 0;
+      if (Tail)
+        Tail->Next = Seg;
+      else
+        Head = Seg;
+      Tail = Seg;
+    }
+    Tail->Diagnostics[Tail->Size++] = diag;
   }
 
   /// Steal the diagnostics from the given pool.
   void steal(DelayedDiagnosticPool &pool) {
-    if (pool.Diagnostics.empty()) return;
+    if (pool.pool_empty()) return;
+
+    if (Tail)
+      Tail->Next = pool.Head;
+    else
+      Head = pool.Head;
+    Tail = pool.Tail;
+    pool.Head = pool.Tail = 0;
+  }
 
-    if (Diagnostics.empty()) {
-      Diagnostics = llvm_move(pool.Diagnostics);
-    } else {
-      Diagnostics.append(pool.pool_begin(), pool.pool_end());
+  /// Iterates over the diagnostics in this pool, in the order they were
+  /// added.
+  class pool_iterator {
+    const Segment *Seg;
+    unsigned Index;
+
+  public:
+    typedef const DelayedDiagnostic value_type;
+    typedef const DelayedDiagnostic &reference;
+    typedef const DelayedDiagnostic *pointer;
+    typedef std::forward_iterator_tag iterator_category;
+    typedef std::ptrdiff_t difference_type;
+
+    explicit pool_iterator(const Segment *Seg = 0) : Seg(Seg), Index(0) {}
+
+    reference operator*() const { return Seg->Diagnostics[Index]; }
+    pointer operator->() const { return &Seg->Diagnostics[Index]; }
+
+    pool_iterator &operator++() {
+      if (++Index == Seg->Size) {
+        Seg = Seg->Next;
+        Index = 0;
+      }
+      return *this;
     }
-    pool.Diagnostics.clear();
-  }
 
-  typedef SmallVectorImpl<DelayedDiagnostic>::const_iterator pool_iterator;
-  pool_iterator pool_begin() const { return Diagnostics.begin(); }
-  pool_iterator pool_end() const { return Diagnostics.end(); }
-  bool pool_empty() const { return Diagnostics.empty(); }
+    pool_iterator operator++(int) {
+      pool_iterator Tmp(*this);
+      ++*this;
+      return Tmp;
+    }
+
+    friend bool operator==(pool_iterator X, pool_iterator Y) {
+      return X.Seg == Y.Seg && X.Index == Y.Index;
+    }
+    friend bool operator!=(pool_iterator X, pool_iterator Y) {
+      return !(X == Y);
+    }
+  };
+
+  pool_iterator pool_begin() const { return pool_iterator(Head); }
+  pool_iterator pool_end() const { return pool_iterator(); }
+  bool pool_empty() const { return Head == 0; }
 };
 
 }
@@ -191,6 +191,11 @@ public:
                  llvm::DenseMap<const CXXRecordDecl *, CharUnits> &BaseOffsets,
           llvm::DenseMap<const CXXRecordDecl *, CharUnits> &VirtualBaseOffsets);
 
+  /// \brief Provide the vtable related information of the given class.
+  ///
+  /// \returns true if any of the sources provided the vtable layout.
+  virtual bool layoutVTable(const CXXRecordDecl *RD, VTableLayoutInfo &Info);
+
   /// Return the amount of memory used by memory buffers, breaking down
   /// by heap-backed versus mmap'ed memory.
   virtual void getMemoryBufferSizes(MemoryBufferSizes &sizes) const;
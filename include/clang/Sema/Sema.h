@@ -45,6 +45,7 @@
 #include "llvm/ADT/SetVector.h"
 #include "llvm/ADT/SmallPtrSet.h"
 #include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringMap.h"
 #include <deque>
 #include <string>
 
@@ -116,6 +117,7 @@ namespace clang {
   class LocalInstantiationScope;
   class LookupResult;
   class MacroInfo;
+  class MemoryReport;
   class MultiLevelTemplateArgumentList;
   class NamedDecl;
   class NonNullAttr;
@@ -170,6 +172,10 @@ namespace clang {
   class VisibleDeclConsumer;
   class IndirectFieldDecl;
 
+namespace analyze_format_string {
+  class RecordedFormatString;
+}
+
 namespace sema {
   class AccessedEntity;
   class BlockScopeInfo;
@@ -181,6 +187,7 @@ namespace sema {
   class LambdaScopeInfo;
   class PossiblyUnreachableDiag;
   class TemplateDeductionInfo;
+  class TimeTrace;
 }
 
 // FIXME: No way to easily map from TemplateTypeParmTypes to
@@ -584,6 +591,10 @@ public:
   /// have been declared.
   bool GlobalNewDeleteDeclared;
 
+  /// \brief Whether any declaration has been given an attribute that the
+  /// thread safety analysis reads.
+  bool SeenThreadSafetyAttributes;
+
   /// \brief Describes how the expressions currently being parsed are
   /// evaluated at run-time, if at all.
   enum ExpressionEvaluationContext {
@@ -835,6 +846,10 @@ public:
 
   void PrintStats() const;
 
+  /// \brief Add the memory used by semantic analysis, outside of the
+  /// ASTContext, to the given report.
+  void reportMemoryUsage(MemoryReport &Report) const;
+
   /// \brief Helper class that creates diagnostics with optional
   /// template instantiation stacks.
   ///
@@ -998,6 +1013,23 @@ public:
   DeclarationNameInfo GetNameFromUnqualifiedId(const UnqualifiedId &Name);
   static QualType GetTypeFromParser(ParsedType Ty, TypeSourceInfo **TInfo = 0);
   CanThrowResult canThrow(const Expr *E);
+
+  /// \brief The results of canThrow() for expressions with subexpressions.
+  llvm::DenseMap<const Expr *, CanThrowResult> CanThrowCache;
+
+  /// \brief Whether a call through a given resolved function type can throw.
+  ///
+  /// This is keyed on the type rather than on the callee, because the type
+  /// of a callee can still change: the exception specification of a
+  /// destructor declared without one is only adjusted once its class is
+  /// complete.
+  llvm::DenseMap<const FunctionProtoType *, CanThrowResult>
+    CalleeCanThrowCache;
+
+  /// \brief Set while computing canThrow() when the result depends on a
+  /// callee whose type may still change, so that it is not cached.
+  bool CanThrowResultIsProvisional;
+
   const FunctionProtoType *ResolveExceptionSpec(SourceLocation Loc,
                                                 const FunctionProtoType *FPT);
   bool CheckSpecifiedExceptionType(QualType &T, const SourceRange &Range);
@@ -2280,6 +2312,20 @@ private:
   /// source.
   bool LoadedExternalKnownNamespaces;
 
+  /// \brief The identifiers known to the external identifier source, bucketed
+  /// by length, for use as typo-correction candidates.
+  ///
+  /// Enumerating every identifier in a precompiled header is expensive, so
+  /// this index is built the first time typo correction needs it and reused
+  /// for the rest of the translation unit. The names point into the storage
+  /// of the external source.
+  SmallVector<std::vector<StringRef>, 32> ExternalTypoCandidates;
+
+  /// \brief Whether ExternalTypoCandidates has been built.
+  bool LoadedExternalTypoCandidates;
+
+  void LoadExternalTypoCandidates(IdentifierInfoLookup *External);
+
 public:
   /// \brief Look up a name, looking for a single declaration.  Return
   /// null if the results were absent, ambiguous, or overloaded.
@@ -5925,6 +5971,7 @@ public:
     bool SavedInNonInstantiationSFINAEContext;
     bool CheckInstantiationDepth(SourceLocation PointOfInstantiation,
                                  SourceRange InstantiationRange);
+    void Push(const ActiveTemplateInstantiation &Inst);
 
     InstantiatingTemplate(const InstantiatingTemplate&) LLVM_DELETED_FUNCTION;
 
@@ -6004,9 +6051,27 @@ public:
   /// string represents a keyword.
   UnqualifiedTyposCorrectedMap UnqualifiedTyposCorrected;
 
+  typedef std::pair<IdentifierInfo *, std::pair<DeclContext *, DeclContext *> >
+    QualifiedTypoKey;
+  typedef llvm::DenseMap<QualifiedTypoKey, TypoCorrection>
+    QualifiedTyposCorrectedMap;
+
+  /// \brief A cache containing the results of typo correction for qualified
+  /// and member name lookup.
+  ///
+  /// The key is the typo, the (primary) context that was searched and the
+  /// context in which the typo occurred, since the latter determines how
+  /// corrections to other namespaces are spelled. An empty correction records
+  /// that no correction was found.
+  QualifiedTyposCorrectedMap QualifiedTyposCorrected;
+
   /// \brief Worker object for performing CFG-based warnings.
   sema::AnalysisBasedWarnings AnalysisWarnings;
 
+  /// \brief If non-null, the trace of template instantiations, overload
+  /// resolution and constant evaluation being collected (-ftime-trace).
+  OwningPtr<sema::TimeTrace> TimeTracer;
+
   /// \brief An entity for which implicit template instantiation is required.
   ///
   /// The source location associated with the declaration is the first place in
@@ -6030,6 +6095,18 @@ public:
   /// types, static variables, enumerators, etc.
   std::deque<PendingImplicitInstantiation> PendingLocalImplicitInstantiations;
 
+  /// \brief The implicit instantiations that were performed while building
+  /// a precompiled header with -fpch-instantiate-templates.
+  ///
+  /// These are serialized along with the pending instantiations, so that a
+  /// translation unit importing the PCH can reuse the instantiated
+  /// definitions rather than instantiating them again.
+  SmallVector<PendingImplicitInstantiation, 16> PrefixInstantiations;
+
+  /// \brief The function definitions loaded from an AST file that have
+  /// already been passed to the AST consumer as reused instantiations.
+  llvm::SmallPtrSet<const FunctionDecl *, 16> ReusedASTFileInstantiations;
+
   void PerformPendingInstantiations(bool LocalOnly = false);
 
   TypeSourceInfo *SubstType(TypeSourceInfo *T,
@@ -7359,6 +7436,20 @@ private:
                          FormatStringType Type, bool inFunctionCall,
                          VariadicCallType CallType);
 
+  /// \brief Format strings that have already been parsed, keyed by the kind
+  /// of format string and its contents, so that a literal used by many calls
+  /// is only parsed once. The language options and target that affect the
+  /// parse are fixed for the translation unit.
+  llvm::StringMap<analyze_format_string::RecordedFormatString *>
+    ParsedFormatStrings;
+
+  /// \brief The number of format strings checked.
+  unsigned NumFormatStringChecks;
+
+  /// \brief The number of format strings checked that had already been
+  /// parsed.
+  unsigned NumFormatStringReuses;
+
   bool CheckFormatArguments(const FormatAttr *Format,
                             ArrayRef<const Expr *> Args,
                             bool IsCXXMember,
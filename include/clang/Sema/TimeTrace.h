@@ -0,0 +1,108 @@
+//===--- TimeTrace.h - Profiling of semantic analysis -----------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+//  This file defines the TimeTrace class, which records how much time and
+//  memory semantic analysis spends in template instantiations, overload
+//  resolution and constant evaluation, and writes them out in the Chrome
+//  trace-event format.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_CLANG_SEMA_TIMETRACE_H
+#define LLVM_CLANG_SEMA_TIMETRACE_H
+
+#include "clang/Basic/LLVM.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringRef.h"
+#include "llvm/Support/Timer.h"
+#include <string>
+#include <vector>
+
+namespace clang {
+namespace sema {
+
+/// \brief Records a trace of the expensive parts of semantic analysis.
+///
+/// Each traced activity is bracketed by calls to begin() and end(); the
+/// activities nest, and the depth of each one is recorded along with its
+/// wall time and the change in heap usage while it was active.
+class TimeTrace {
+public:
+  /// \brief The kinds of activity that are traced.
+  enum EventKind {
+    TemplateInstantiation,
+    OverloadResolution,
+    ConstantEvaluation
+  };
+
+  /// \brief A completed activity.
+  struct Event {
+    EventKind Kind;
+    std::string Name;
+    /// \brief Start time, in seconds since the trace was created.
+    double Start;
+    /// \brief Wall time spent in the activity, in seconds.
+    double Duration;
+    /// \brief The change in heap usage over the activity, in bytes.
+    int64_t MemoryDelta;
+    /// \brief The number of enclosing traced activities.
+    unsigned Depth;
+  };
+
+private:
+  struct OpenEvent {
+    EventKind Kind;
+    std::string Name;
+    llvm::TimeRecord Start;
+  };
+
+  llvm::TimeRecord Origin;
+  SmallVector<OpenEvent, 16> Stack;
+  std::vector<Event> Events;
+
+public:
+  TimeTrace();
+
+  /// \brief Start tracing an activity of the given kind.
+  void begin(EventKind Kind, StringRef Name);
+
+  /// \brief Finish tracing the innermost activity.
+  void end();
+
+  const std::vector<Event> &getEvents() const { return Events; }
+
+  /// \brief Write the completed activities as a Chrome trace-event JSON
+  /// document.
+  void writeJSON(raw_ostream &OS) const;
+
+  static const char *getKindName(EventKind Kind);
+};
+
+/// \brief RAII object that traces an activity for the duration of a scope,
+/// if a trace is being collected.
+class TimeTraceScope {
+  TimeTrace *Trace;
+
+public:
+  TimeTraceScope(TimeTrace *Trace, TimeTrace::EventKind Kind, StringRef Name)
+    : Trace(Trace) {
+    if (Trace)
+      Trace->begin(Kind, Name);
+  }
+
+  ~TimeTraceScope() {
+    if (Trace)
+      Trace->end();
+  }
+};
+
+} // end namespace sema
+} // end namespace clang
+
+#endif
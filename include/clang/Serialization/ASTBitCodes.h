@@ -528,7 +528,16 @@ namespace clang {
 
       /// \brief Record code for undefined but used functions and variables that
       /// need a definition in this TU.
-      UNDEFINED_BUT_USED = 49
+      UNDEFINED_BUT_USED = 49,
+
+      /// \brief Record code for the layouts of the records defined in this
+      /// AST file that were laid out while it was being built.
+      RECORD_LAYOUTS = 50,
+
+      /// \brief Record code for the vtable layouts of the dynamic classes
+      /// defined in this AST file, along with their thunks and virtual base
+      /// offset offsets.
+      VTABLE_LAYOUTS = 51
     };
 
     /// \brief Record types used within a source manager block.
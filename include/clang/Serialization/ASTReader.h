@@ -72,6 +72,7 @@ class GlobalModuleIndex;
 class GotoStmt;
 class MacroDefinition;
 class MacroDirective;
+class MemoryReport;
 class NamedDecl;
 class OpaqueValueExpr;
 class Preprocessor;
@@ -687,6 +688,37 @@ private:
   SmallVector<serialization::SubmoduleID, 2> ImportedModules;
   //@}
 
+  /// \brief The layout of a record, as written to an AST file. Classes with
+  /// virtual bases are not written.
+  struct SerializedRecordLayout {
+    uint64_t Size;
+    uint64_t Alignment;
+    SmallVector<uint64_t, 8> FieldOffsets;
+    SmallVector<std::pair<serialization::DeclID, uint64_t>, 2> BaseOffsets;
+  };
+
+  /// \brief The layouts of the records that were laid out while the AST
+  /// files were built, keyed by the global ID of the record definition.
+  llvm::DenseMap<serialization::DeclID, SerializedRecordLayout> RecordLayouts;
+
+  /// \brief Where the vtable related information of a dynamic class is
+  /// stored within \c VTableLayoutData.
+  struct SerializedVTableLayout {
+    /// \brief The module file that the information was read from, which
+    /// maps the declaration IDs within it.
+    ModuleFile *F;
+    unsigned Offset;
+    unsigned Length;
+  };
+
+  /// \brief The vtable related information of the dynamic classes defined
+  /// in the AST files, keyed by the global ID of the class definition. The
+  /// entries are only decoded when the vtable layout of the class is needed.
+  llvm::DenseMap<serialization::DeclID, SerializedVTableLayout> VTableLayouts;
+
+  /// \brief The entries of the VTABLE_LAYOUTS records, as written.
+  SmallVector<uint64_t, 0> VTableLayoutData;
+
   /// \brief The directory that the PCH we are reading is stored in.
   std::string CurrentDir;
 
@@ -727,6 +759,12 @@ private:
   /// \brief The number of source location entries in the chain.
   unsigned TotalNumSLocEntries;
 
+  /// \brief The number of record layouts handed out from \c RecordLayouts.
+  unsigned NumRecordLayoutsReused;
+
+  /// \brief The number of vtable layouts handed out from \c VTableLayouts.
+  unsigned NumVTableLayoutsReused;
+
   /// \brief The number of statements (and expressions) de-serialized
   /// from the chain.
   unsigned NumStatementsRead;
@@ -1508,6 +1546,10 @@ public:
   /// by heap-backed versus mmap'ed memory.
   virtual void getMemoryBufferSizes(MemoryBufferSizes &sizes) const;
 
+  /// \brief Add the memory used by each loaded AST file, and by the tables
+  /// that map its IDs to deserialized entities, to the given report.
+  void reportMemoryUsage(MemoryReport &Report) const;
+
   /// \brief Initialize the semantic source with the Sema instance
   /// being used to perform semantic analysis on the abstract syntax
   /// tree.
@@ -1543,6 +1585,19 @@ public:
   virtual void ReadUndefinedButUsed(
                         llvm::DenseMap<NamedDecl *, SourceLocation> &Undefined);
 
+  /// \brief Provide the layout of a record that was laid out while the AST
+  /// file defining it was built.
+  virtual bool
+  layoutRecordType(const RecordDecl *Record,
+                   uint64_t &Size, uint64_t &Alignment,
+                   llvm::DenseMap<const FieldDecl *, uint64_t> &FieldOffsets,
+                 llvm::DenseMap<const CXXRecordDecl *, CharUnits> &BaseOffsets,
+          llvm::DenseMap<const CXXRecordDecl *, CharUnits> &VirtualBaseOffsets);
+
+  /// \brief Provide the vtable related information of a dynamic class that
+  /// was computed while the AST file defining it was built.
+  virtual bool layoutVTable(const CXXRecordDecl *RD, VTableLayoutInfo &Info);
+
   virtual void ReadTentativeDefinitions(
                  SmallVectorImpl<VarDecl *> &TentativeDefs);
 
@@ -13,6 +13,7 @@
 
 #include "clang/AST/ASTContext.h"
 #include "CXXABI.h"
+#include "ConstexprCallCache.h"
 #include "clang/AST/ASTMutationListener.h"
 #include "clang/AST/Attr.h"
 #include "clang/AST/CharUnits.h"
@@ -51,6 +52,8 @@ unsigned ASTContext::NumImplicitMoveAssignmentOperators;
 unsigned ASTContext::NumImplicitMoveAssignmentOperatorsDeclared;
 unsigned ASTContext::NumImplicitDestructors;
 unsigned ASTContext::NumImplicitDestructorsDeclared;
+unsigned ASTContext::NumUniquingCandidates;
+unsigned ASTContext::NumUniquingCandidatesRejectedByHash;
 
 enum FloatingRank {
   HalfRank, FloatRank, DoubleRank, LongDoubleRank
@@ -590,6 +593,36 @@ ASTContext::getCanonicalTemplateTemplateParmDecl(
   return CanonTTP;
 }
 
+ConstexprCallCache &ASTContext::getConstexprCallCache() const {
+  if (!ConstexprCalls)
+    ConstexprCalls.reset(new ConstexprCallCache);
+  return *ConstexprCalls;
+}
+
+const ParentIndex &ASTContext::getParentIndex() {
+  // We always need to run over the whole translation unit, as hasAncestor can
+  // escape any subtree.
+  if (!AllParents)
+    AllParents.reset(ParentIndex::build(*getTranslationUnitDecl()));
+  return *AllParents;
+}
+
+ASTContext::ParentVector
+ASTContext::getParents(const ast_type_traits::DynTypedNode &Node) {
+  assert(Node.getMemoizationData() &&
+         "Invariant broken: only nodes that support memoization may be "
+         "used in the parent map.");
+  const ParentIndex &Index = getParentIndex();
+  ParentIndex::NodeID ID = Index.getNodeID(Node);
+  ParentVector Result;
+  if (ID == ParentIndex::InvalidNodeID)
+    return Result;
+  ArrayRef<ParentIndex::NodeID> Parents = Index.getParentIDs(ID);
+  for (unsigned I = 0, N = Parents.size(); I != N; ++I)
+    Result.push_back(Index.getNode(Parents[I]));
+  return Result;
+}
+
 CXXABI *ASTContext::createCXXABI(const TargetInfo &T) {
   if (!LangOpts.CPlusPlus) return 0;
 
@@ -757,6 +790,16 @@ void ASTContext::PrintStats() const {
   llvm::errs() << NumImplicitDestructorsDeclared << "/"
                << NumImplicitDestructors
                << " implicit destructors created\n";
+  llvm::errs() << NumUniquingCandidatesRejectedByHash << "/"
+               << NumUniquingCandidates
+               << " uniquing candidates rejected by profile hash\n";
+  if (getLangOpts().CPlusPlus)
+    llvm::errs() << (ConstexprCalls ? ConstexprCalls->size() : 0)
+                 << " constexpr call results cached\n";
+  PrintDeclContextMapStats();
+  if (AllParents)
+    llvm::errs() << AllParents->size() << " nodes in the parent index, "
+                 << AllParents->getMemorySize() << " bytes\n";
 
   if (ExternalSource.get()) {
     llvm::errs() << "\n";
@@ -995,6 +1038,24 @@ void ASTContext::setClassScopeSpecializationPattern(FunctionDecl *FD,
   ClassScopeSpecializationPattern[FD] = Pattern;
 }
 
+ArrayRef<NamedDecl *>
+ASTContext::getDeclsInPrototypeScope(const FunctionDecl *FD) const {
+  llvm::DenseMap<const FunctionDecl*, ArrayRef<NamedDecl *> >::const_iterator
+    Pos = DeclsInPrototypeScope.find(FD);
+  if (Pos == DeclsInPrototypeScope.end())
+    return ArrayRef<NamedDecl *>();
+
+  return Pos->second;
+}
+
+void ASTContext::setDeclsInPrototypeScope(const FunctionDecl *FD,
+                                          ArrayRef<NamedDecl *> Decls) {
+  assert(!DeclsInPrototypeScope.count(FD) && "Already has prototype decls!");
+  NamedDecl **A = new (*this) NamedDecl*[Decls.size()];
+  std::copy(Decls.begin(), Decls.end(), A);
+  DeclsInPrototypeScope[FD] = ArrayRef<NamedDecl *>(A, Decls.size());
+}
+
 NamedDecl *
 ASTContext::getInstantiatedFromUsingDecl(UsingDecl *UUD) {
   llvm::DenseMap<UsingDecl *, NamedDecl *>::const_iterator Pos
@@ -2727,6 +2788,7 @@ ASTContext::getFunctionType(QualType ResultTy, ArrayRef<QualType> ArgArray,
   FunctionProtoType::ExtProtoInfo newEPI = EPI;
   newEPI.ExtInfo = EPI.ExtInfo.withCallingConv(CallConv);
   new (FTP) FunctionProtoType(ResultTy, ArgArray, Canonical, newEPI);
+  FTP->ProfileHash = ID.ComputeHash();
   Types.push_back(FTP);
   FunctionProtoTypes.InsertNode(FTP, InsertPos);
   return QualType(FTP, 0);
@@ -3080,6 +3142,7 @@ ASTContext::getCanonicalTemplateSpecializationType(TemplateName Template,
     Spec = new (Mem) TemplateSpecializationType(CanonTemplate,
                                                 CanonArgs.data(), NumArgs,
                                                 QualType(), QualType());
+    Spec->ProfileHash = ID.ComputeHash();
     Types.push_back(Spec);
     TemplateSpecializationTypes.InsertNode(Spec, InsertPos);
   }
@@ -7773,7 +7836,9 @@ size_t ASTContext::getSideTableAllocatedMemory() const {
     + llvm::capacity_in_bytes(OverriddenMethods)
     + llvm::capacity_in_bytes(Types)
     + llvm::capacity_in_bytes(VariableArrayTypes)
-    + llvm::capacity_in_bytes(ClassScopeSpecializationPattern);
+    + llvm::capacity_in_bytes(ClassScopeSpecializationPattern)
+    + llvm::capacity_in_bytes(DeclsInPrototypeScope)
+    + llvm::capacity_in_bytes(CXXBaseSets);
 }
 
 void ASTContext::addUnnamedTag(const TagDecl *Tag) {
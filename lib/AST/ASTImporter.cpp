@@ -2142,18 +2142,32 @@ bool ASTNodeImporter::ImportTemplateArguments(const TemplateArgument *FromArgs,
 
 bool ASTNodeImporter::IsStructuralMatch(RecordDecl *FromRecord, 
                                         RecordDecl *ToRecord, bool Complain) {
+  if (Importer.isKnownEquivalent(FromRecord, ToRecord))
+    return true;
+
   StructuralEquivalenceContext Ctx(Importer.getFromContext(),
                                    Importer.getToContext(),
                                    Importer.getNonEquivalentDecls(),
                                    false, Complain);
-  return Ctx.IsStructurallyEquivalent(FromRecord, ToRecord);
+  if (!Ctx.IsStructurallyEquivalent(FromRecord, ToRecord))
+    return false;
+
+  Importer.noteEquivalent(FromRecord, ToRecord);
+  return true;
 }
 
 bool ASTNodeImporter::IsStructuralMatch(EnumDecl *FromEnum, EnumDecl *ToEnum) {
+  if (Importer.isKnownEquivalent(FromEnum, ToEnum))
+    return true;
+
   StructuralEquivalenceContext Ctx(Importer.getFromContext(),
                                    Importer.getToContext(),
                                    Importer.getNonEquivalentDecls());
-  return Ctx.IsStructurallyEquivalent(FromEnum, ToEnum);
+  if (!Ctx.IsStructurallyEquivalent(FromEnum, ToEnum))
+    return false;
+
+  Importer.noteEquivalent(FromEnum, ToEnum);
+  return true;
 }
 
 bool ASTNodeImporter::IsStructuralMatch(EnumConstantDecl *FromEC,
@@ -2399,8 +2413,11 @@ Decl *ASTNodeImporter::VisitEnumDecl(EnumDecl *D) {
   D2->setIntegerType(ToIntegerType);
   
   // Import the definition
-  if (D->isCompleteDefinition() && ImportDefinition(D, D2))
-    return 0;
+  if (D->isCompleteDefinition()) {
+    if (ImportDefinition(D, D2))
+      return 0;
+    Importer.noteEquivalent(D, D2);
+  }
 
   return D2;
 }
@@ -2522,8 +2539,11 @@ Decl *ASTNodeImporter::VisitRecordDecl(RecordDecl *D) {
   
   Importer.Imported(D, D2);
 
-  if (D->isCompleteDefinition() && ImportDefinition(D, D2, IDK_Default))
-    return 0;
+  if (D->isCompleteDefinition()) {
+    if (ImportDefinition(D, D2, IDK_Default))
+      return 0;
+    Importer.noteEquivalent(D, D2);
+  }
   
   return D2;
 }
@@ -4328,7 +4348,7 @@ ASTImporter::ASTImporter(ASTContext &ToContext, FileManager &ToFileManager,
                          bool MinimalImport)
   : ToContext(ToContext), FromContext(FromContext),
     ToFileManager(ToFileManager), FromFileManager(FromFileManager),
-    Minimal(MinimalImport), LastDiagFromFrom(false)
+    Minimal(MinimalImport), LastDiagFromFrom(false), SharedIndex(0)
 {
   ImportedDecls[FromContext.getTranslationUnitDecl()]
     = ToContext.getTranslationUnitDecl();
@@ -4882,3 +4902,30 @@ bool ASTImporter::IsStructurallyEquivalent(QualType From, QualType To,
                                    false, Complain);
   return Ctx.IsStructurallyEquivalent(From, To);
 }
+
+bool ASTImporter::hashFromTag(TagDecl *From, DeclHash &Hash) {
+  if (!SharedIndex || !From->isCompleteDefinition())
+    return false;
+  if (!FromHasher)
+    FromHasher.reset(new DeclHasher(FromContext));
+  return FromHasher->hashStructure(From, Hash);
+}
+
+bool ASTImporter::isKnownEquivalent(TagDecl *From, TagDecl *To) {
+  DeclHash Hash;
+  if (!To->isCompleteDefinition() || !hashFromTag(From, Hash))
+    return false;
+
+  TagDecl *Known = SharedIndex->lookup(Hash);
+  return Known && Known->getCanonicalDecl() == To->getCanonicalDecl();
+}
+
+void ASTImporter::noteEquivalent(TagDecl *From, TagDecl *To) {
+  // The structural hash only covers complete definitions, and an invalid
+  // definition may not have been imported in full. The definition is
+  // recorded under its own hash rather than that of the "from" tag, so that
+  // a later hit does not depend on the comparison that led here.
+  if (SharedIndex && To->isCompleteDefinition() && !From->isInvalidDecl() &&
+      !To->isInvalidDecl())
+    SharedIndex->insert(To);
+}
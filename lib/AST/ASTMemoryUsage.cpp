@@ -0,0 +1,213 @@
+//===--- ASTMemoryUsage.cpp - Memory used by an ASTContext ----------------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+//  This file implements ASTContext::reportMemoryUsage, which breaks down the
+//  memory used by an ASTContext by kind of AST node, and checks the size
+//  budgets of the most common node classes.
+//
+//===----------------------------------------------------------------------===//
+
+#include "clang/AST/ASTContext.h"
+#include "clang/AST/Decl.h"
+#include "clang/AST/DeclCXX.h"
+#include "clang/AST/DeclFriend.h"
+#include "clang/AST/DeclObjC.h"
+#include "clang/AST/DeclTemplate.h"
+#include "clang/AST/ExprCXX.h"
+#include "clang/AST/ExprObjC.h"
+#include "clang/AST/Stmt.h"
+#include "clang/AST/StmtCXX.h"
+#include "clang/AST/StmtObjC.h"
+#include "clang/Basic/MemoryReport.h"
+#include "llvm/ADT/DenseSet.h"
+#include "llvm/ADT/SmallVector.h"
+#include <algorithm>
+using namespace clang;
+
+//===----------------------------------------------------------------------===//
+// Size budgets
+//===----------------------------------------------------------------------===//
+
+// Every byte added to these classes is paid for by each node of the class in
+// every translation unit held in memory. Fields that few nodes need belong in
+// a side table of the ASTContext or in trailing storage allocated on demand;
+// raise a budget only deliberately.
+//
+// The budgets are in bytes for the Itanium C++ ABI on LP64 hosts. Other
+// layouts, notably MSVC's treatment of bit-fields, are not checked.
+#if !defined(_MSC_VER)
+#define CHECK_NODE_SIZE(CLASS, BUDGET)                                  \
+  typedef char CLASS##_exceeds_its_size_budget[                        \
+    sizeof(void *) != 8 || sizeof(CLASS) <= (BUDGET) ? 1 : -1]
+CHECK_NODE_SIZE(Decl, 32);
+CHECK_NODE_SIZE(NamedDecl, 40);
+CHECK_NODE_SIZE(ValueDecl, 48);
+CHECK_NODE_SIZE(DeclaratorDecl, 64);
+CHECK_NODE_SIZE(FunctionDecl, 144);
+CHECK_NODE_SIZE(Stmt, 8);
+CHECK_NODE_SIZE(Expr, 16);
+CHECK_NODE_SIZE(MemberExpr, 40);
+#undef CHECK_NODE_SIZE
+#endif
+
+namespace {
+
+/// \brief The number of declaration kinds.
+const unsigned NumDeclKinds = 0
+#define DECL(DERIVED, BASE) + 1
+#define ABSTRACT_DECL(DECL)
+#include "clang/AST/DeclNodes.inc"
+  ;
+
+/// \brief Counts the declarations and statements of a translation unit that
+/// are owned by the ASTContext, without deserializing anything.
+///
+/// The walk uses explicit worklists rather than recursion, so that deeply
+/// nested expressions cannot exhaust the stack.
+class NodeCounter {
+  llvm::DenseSet<const Decl *> VisitedDecls;
+  llvm::DenseSet<const Stmt *> VisitedStmts;
+  SmallVector<const Decl *, 16> DeclWorklist;
+  SmallVector<const Stmt *, 16> StmtWorklist;
+
+  void addDecl(const Decl *D) {
+    // Declarations loaded from an AST file are accounted to that file;
+    // looking into them could deserialize more of it.
+    if (D && !D->isFromASTFile() && VisitedDecls.insert(D).second)
+      DeclWorklist.push_back(D);
+  }
+
+  void addStmt(const Stmt *S) {
+    if (S && VisitedStmts.insert(S).second)
+      StmtWorklist.push_back(S);
+  }
+
+  void visitDecl(const Decl *D);
+  void visitStmt(const Stmt *S);
+
+public:
+  unsigned DeclCounts[NumDeclKinds];
+  unsigned StmtCounts[Stmt::lastStmtConstant + 1];
+
+  NodeCounter() {
+    std::fill(DeclCounts, DeclCounts + NumDeclKinds, 0);
+    std::fill(StmtCounts, StmtCounts + Stmt::lastStmtConstant + 1, 0);
+  }
+
+  /// \brief Count the given declaration and everything it contains.
+  void count(const Decl *D) {
+    addDecl(D);
+    while (!DeclWorklist.empty() || !StmtWorklist.empty()) {
+      if (!StmtWorklist.empty())
+        visitStmt(StmtWorklist.pop_back_val());
+      else
+        visitDecl(DeclWorklist.pop_back_val());
+    }
+  }
+};
+
+} // end anonymous namespace
+
+void NodeCounter::visitDecl(const Decl *D) {
+  ++DeclCounts[D->getKind()];
+
+  if (const FunctionDecl *FD = dyn_cast<FunctionDecl>(D)) {
+    if (FD->doesThisDeclarationHaveABody())
+      addStmt(FD->getBody());
+    if (const CXXConstructorDecl *CD = dyn_cast<CXXConstructorDecl>(FD))
+      for (CXXConstructorDecl::init_const_iterator I = CD->init_begin(),
+                                                   E = CD->init_end();
+           I != E; ++I)
+        addStmt((*I)->getInit());
+  } else if (const ObjCMethodDecl *MD = dyn_cast<ObjCMethodDecl>(D)) {
+    addStmt(MD->getBody());
+  } else if (const BlockDecl *BD = dyn_cast<BlockDecl>(D)) {
+    addStmt(BD->getBody());
+  } else if (const VarDecl *VD = dyn_cast<VarDecl>(D)) {
+    addStmt(VD->getInit());
+  } else if (const FieldDecl *FD = dyn_cast<FieldDecl>(D)) {
+    addStmt(FD->getBitWidth());
+    addStmt(FD->getInClassInitializer());
+  } else if (const EnumConstantDecl *ECD = dyn_cast<EnumConstantDecl>(D)) {
+    addStmt(ECD->getInitExpr());
+  } else if (const ClassTemplateDecl *TD = dyn_cast<ClassTemplateDecl>(D)) {
+    addDecl(TD->getTemplatedDecl());
+    // Implicit instantiations are not members of any declaration context.
+    for (ClassTemplateDecl::spec_iterator I = TD->spec_begin(),
+                                          E = TD->spec_end();
+         I != E; ++I)
+      addDecl(*I);
+  } else if (const FunctionTemplateDecl *TD
+               = dyn_cast<FunctionTemplateDecl>(D)) {
+    addDecl(TD->getTemplatedDecl());
+    for (FunctionTemplateDecl::spec_iterator I = TD->spec_begin(),
+                                             E = TD->spec_end();
+         I != E; ++I)
+      addDecl(*I);
+  } else if (const TemplateDecl *TD = dyn_cast<TemplateDecl>(D)) {
+    addDecl(TD->getTemplatedDecl());
+  }
+
+  if (const DeclContext *DC = dyn_cast<DeclContext>(D))
+    for (DeclContext::decl_iterator I = DC->noload_decls_begin(),
+                                    E = DC->noload_decls_end();
+         I != E; ++I)
+      addDecl(*I);
+}
+
+void NodeCounter::visitStmt(const Stmt *S) {
+  ++StmtCounts[S->getStmtClass()];
+
+  for (Stmt::const_child_range C = S->children(); C; ++C)
+    addStmt(*C);
+}
+
+void ASTContext::reportMemoryUsage(MemoryReport &Report) const {
+  Report.add("ASTContext", "allocator", 0, getASTAllocatedMemory());
+  Report.add("ASTContext", "side tables", 0, getSideTableAllocatedMemory());
+
+  unsigned NumMaps, NumNames, NumVectors;
+  size_t MapBytes = getDeclContextMapsMemory(NumMaps, NumNames, NumVectors);
+  Report.add("LookupTables", "declaration lookup tables", NumMaps, MapBytes);
+  if (AllParents)
+    Report.add("LookupTables", "parent index", AllParents->size(),
+               AllParents->getMemorySize());
+
+  NodeCounter Counter;
+  Counter.count(getTranslationUnitDecl());
+
+  // Declarations.
+#define DECL(DERIVED, BASE)                                             \
+  if (unsigned Count = Counter.DeclCounts[Decl::DERIVED])               \
+    Report.add("Decls", #DERIVED, Count, Count * sizeof(DERIVED##Decl));
+#define ABSTRACT_DECL(DECL)
+#include "clang/AST/DeclNodes.inc"
+
+  // Statements and expressions.
+#define STMT(CLASS, PARENT)                                             \
+  if (unsigned Count = Counter.StmtCounts[Stmt::CLASS##Class])          \
+    Report.add("Stmts", #CLASS, Count, Count * sizeof(CLASS));
+#define ABSTRACT_STMT(STMT)
+#include "clang/AST/StmtNodes.inc"
+
+  // Types, including those loaded from AST files.
+  unsigned TypeCounts[] = {
+#define TYPE(Name, Parent) 0,
+#define ABSTRACT_TYPE(Name, Parent)
+#include "clang/AST/TypeNodes.def"
+    0 // Extra
+  };
+  for (unsigned I = 0, N = Types.size(); I != N; ++I)
+    ++TypeCounts[Types[I]->getTypeClass()];
+#define TYPE(Name, Parent)                                              \
+  if (unsigned Count = TypeCounts[Type::Name])                          \
+    Report.add("Types", #Name, Count, Count * sizeof(Name##Type));
+#define ABSTRACT_TYPE(Name, Parent)
+#include "clang/AST/TypeNodes.def"
+}
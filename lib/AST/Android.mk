@@ -30,6 +30,7 @@ clang_ast_SRC_FILES :=	\
 	ASTDiagnostic.cpp	\
 	ASTDumper.cpp	\
 	ASTImporter.cpp	\
+	ASTMemoryUsage.cpp	\
 	AttrImpl.cpp	\
 	Comment.cpp \
 	CommentBriefParser.cpp \
@@ -45,6 +46,7 @@ clang_ast_SRC_FILES :=	\
 	DeclFriend.cpp	\
 	DeclGroup.cpp	\
 	DeclObjC.cpp	\
+	DeclHasher.cpp	\
 	DeclPrinter.cpp	\
 	DeclTemplate.cpp	\
 	DumpXML.cpp	\
@@ -62,6 +64,7 @@ clang_ast_SRC_FILES :=	\
 	MicrosoftMangle.cpp	\
 	NestedNameSpecifier.cpp	\
         NSAPI.cpp       \
+	ParentIndex.cpp	\
 	ParentMap.cpp	\
 	RecordLayout.cpp	\
 	RecordLayoutBuilder.cpp	\
@@ -77,7 +77,100 @@ void CXXBasePaths::swap(CXXBasePaths &Other) {
   std::swap(DetectedVirtual, Other.DetectedVirtual);
 }
 
+static bool EntryBaseLess(const CXXBaseSet::Entry &E,
+                          const CXXRecordDecl *Base) {
+  return E.Base < Base;
+}
+
+static bool EntryLess(const CXXBaseSet::Entry &LHS,
+                      const CXXBaseSet::Entry &RHS) {
+  return LHS.Base < RHS.Base;
+}
+
+const CXXBaseSet::Entry *CXXBaseSet::find(const CXXRecordDecl *Base) const {
+  Base = Base->getCanonicalDecl();
+  iterator I = std::lower_bound(begin(), end(), Base, EntryBaseLess);
+  if (I == end() || I->Base != Base)
+    return 0;
+  return I;
+}
+
+/// \brief Retrieve the definition of the class named by a base specifier, or
+/// null if it is dependent, invalid or not defined.
+static const CXXRecordDecl *getBaseDefinition(const CXXBaseSpecifier &Base) {
+  if (const CXXRecordDecl *RD = Base.getType()->getAsCXXRecordDecl())
+    return RD->getDefinition();
+  return 0;
+}
+
+const CXXBaseSet *ASTContext::getCXXBaseSet(const CXXRecordDecl *RD) {
+  RD = RD->getDefinition();
+  if (!RD || !RD->isCompleteDefinition() || RD->isDependentContext())
+    return 0;
+
+  llvm::DenseMap<const CXXRecordDecl *, const CXXBaseSet *>::iterator Known
+    = CXXBaseSets.find(RD);
+  if (Known != CXXBaseSets.end())
+    return Known->second;
+
+  // Gather the bases from the sets of the direct bases. Each virtual base is
+  // a single subobject however many times it is named, so the subobjects
+  // within it are counted once, from the virtual bases of this class.
+  llvm::DenseMap<const CXXRecordDecl *, CXXBaseSet::Entry> Found;
+  for (CXXRecordDecl::base_class_const_iterator B = RD->bases_begin(),
+                                             BEnd = RD->bases_end();
+       B != BEnd; ++B) {
+    const CXXRecordDecl *Base = getBaseDefinition(*B);
+    if (!Base)
+      return 0;
+    if (B->isVirtual())
+      continue;
+
+    const CXXBaseSet *BaseSet = getCXXBaseSet(Base);
+    if (!BaseSet)
+      return 0;
+    ++Found[Base->getCanonicalDecl()].NumOwnNonVirtual;
+    for (CXXBaseSet::iterator E = BaseSet->begin(), EEnd = BaseSet->end();
+         E != EEnd; ++E)
+      Found[E->Base].NumOwnNonVirtual += E->NumOwnNonVirtual;
+  }
+  for (CXXRecordDecl::base_class_const_iterator B = RD->vbases_begin(),
+                                             BEnd = RD->vbases_end();
+       B != BEnd; ++B) {
+    const CXXRecordDecl *Base = getBaseDefinition(*B);
+    if (!Base)
+      return 0;
+
+    const CXXBaseSet *BaseSet = getCXXBaseSet(Base);
+    if (!BaseSet)
+      return 0;
+    Found[Base->getCanonicalDecl()].IsVirtual = true;
+    for (CXXBaseSet::iterator E = BaseSet->begin(), EEnd = BaseSet->end();
+         E != EEnd; ++E)
+      Found[E->Base].NumNonVirtual += E->NumOwnNonVirtual;
+  }
+
+  CXXBaseSet::Entry *Entries = new (*this) CXXBaseSet::Entry[Found.size()];
+  unsigned NumEntries = 0;
+  for (llvm::DenseMap<const CXXRecordDecl *, CXXBaseSet::Entry>::iterator
+         I = Found.begin(), E = Found.end();
+       I != E; ++I, ++NumEntries) {
+    CXXBaseSet::Entry &Entry = Entries[NumEntries];
+    Entry = I->second;
+    Entry.Base = I->first;
+    Entry.NumNonVirtual += Entry.NumOwnNonVirtual;
+  }
+  std::sort(Entries, Entries + NumEntries, EntryLess);
+
+  const CXXBaseSet *Bases = new (*this) CXXBaseSet(Entries, NumEntries);
+  CXXBaseSets[RD] = Bases;
+  return Bases;
+}
+
 bool CXXRecordDecl::isDerivedFrom(const CXXRecordDecl *Base) const {
+  if (const CXXBaseSet *Bases = getASTContext().getCXXBaseSet(this))
+    return Bases->contains(Base);
+
   CXXBasePaths Paths(/*FindAmbiguities=*/false, /*RecordPaths=*/false,
                      /*DetectVirtual=*/false);
   return isDerivedFrom(Base, Paths);
@@ -89,6 +182,12 @@ bool CXXRecordDecl::isDerivedFrom(const CXXRecordDecl *Base,
     return false;
   
   Paths.setOrigin(const_cast<CXXRecordDecl*>(this));
+
+  // Only walk the paths when there is one to find.
+  if (const CXXBaseSet *Bases = getASTContext().getCXXBaseSet(this))
+    if (!Bases->contains(Base))
+      return false;
+
   return lookupInBases(&FindBaseClass,
                        const_cast<CXXRecordDecl*>(Base->getCanonicalDecl()),
                        Paths);
@@ -98,6 +197,9 @@ bool CXXRecordDecl::isVirtuallyDerivedFrom(const CXXRecordDecl *Base) const {
   if (!getNumVBases())
     return false;
 
+  if (const CXXBaseSet *Bases = getASTContext().getCXXBaseSet(this))
+    return Bases->isVirtual(Base);
+
   CXXBasePaths Paths(/*FindAmbiguities=*/false, /*RecordPaths=*/false,
                      /*DetectVirtual=*/false);
 
@@ -118,6 +220,9 @@ static bool BaseIsNot(const CXXRecordDecl *Base, void *OpaqueTarget) {
 }
 
 bool CXXRecordDecl::isProvablyNotDerivedFrom(const CXXRecordDecl *Base) const {
+  if (const CXXBaseSet *Bases = getASTContext().getCXXBaseSet(this))
+    return !Bases->contains(Base);
+
   return forallBases(BaseIsNot,
                      const_cast<CXXRecordDecl *>(Base->getCanonicalDecl()));
 }
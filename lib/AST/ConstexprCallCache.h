@@ -0,0 +1,72 @@
+//===--- ConstexprCallCache.h - Results of constexpr calls ------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file defines the ConstexprCallCache class, which remembers the results
+// of calls to constexpr functions made by the constant evaluator.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_CLANG_AST_CONSTEXPRCALLCACHE_H
+#define LLVM_CLANG_AST_CONSTEXPRCALLCACHE_H
+
+#include "clang/AST/APValue.h"
+#include "llvm/ADT/FoldingSet.h"
+
+namespace clang {
+
+/// \brief The results of calls to constexpr functions, keyed by the callee
+/// and the values of the arguments.
+///
+/// The constant evaluator only records calls whose result cannot depend on
+/// anything but the arguments, and which evaluated to a constant expression.
+class ConstexprCallCache {
+  struct Entry : llvm::FastFoldingSetNode {
+    APValue Result;
+
+    Entry(const llvm::FoldingSetNodeID &ID, const APValue &Result)
+      : llvm::FastFoldingSetNode(ID), Result(Result) {}
+  };
+
+  llvm::FoldingSet<Entry> Entries;
+
+  ConstexprCallCache(const ConstexprCallCache &) LLVM_DELETED_FUNCTION;
+  void operator=(const ConstexprCallCache &) LLVM_DELETED_FUNCTION;
+
+public:
+  ConstexprCallCache() {}
+
+  ~ConstexprCallCache() {
+    for (llvm::FoldingSet<Entry>::iterator I = Entries.begin(),
+                                           E = Entries.end();
+         I != E; )
+      delete &*I++;
+  }
+
+  /// \brief Find the result of the call with the given key, or null if it
+  /// has not been recorded.
+  const APValue *lookup(const llvm::FoldingSetNodeID &ID) {
+    void *InsertPos;
+    if (Entry *E = Entries.FindNodeOrInsertPos(ID, InsertPos))
+      return &E->Result;
+    return 0;
+  }
+
+  /// \brief Record the result of the call with the given key.
+  void insert(const llvm::FoldingSetNodeID &ID, const APValue &Result) {
+    void *InsertPos;
+    if (!Entries.FindNodeOrInsertPos(ID, InsertPos))
+      Entries.InsertNode(new Entry(ID, Result), InsertPos);
+  }
+
+  unsigned size() const { return Entries.size(); }
+};
+
+} // end namespace clang
+
+#endif
@@ -2191,13 +2191,18 @@ void FunctionDecl::setParams(ASTContext &C,
   }
 }
 
+ArrayRef<NamedDecl *> FunctionDecl::getDeclsInPrototypeScope() const {
+  if (!HasDeclsInPrototypeScope)
+    return ArrayRef<NamedDecl *>();
+  return getASTContext().getDeclsInPrototypeScope(this);
+}
+
 void FunctionDecl::setDeclsInPrototypeScope(ArrayRef<NamedDecl *> NewDecls) {
-  assert(DeclsInPrototypeScope.empty() && "Already has prototype decls!");
+  assert(!HasDeclsInPrototypeScope && "Already has prototype decls!");
 
   if (!NewDecls.empty()) {
-    NamedDecl **A = new (getASTContext()) NamedDecl*[NewDecls.size()];
-    std::copy(NewDecls.begin(), NewDecls.end(), A);
-    DeclsInPrototypeScope = ArrayRef<NamedDecl *>(A, NewDecls.size());
+    getASTContext().setDeclsInPrototypeScope(this, NewDecls);
+    HasDeclsInPrototypeScope = true;
   }
 }
 
@@ -28,6 +28,8 @@
 #include "clang/AST/Type.h"
 #include "clang/Basic/TargetInfo.h"
 #include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/DenseSet.h"
+#include "llvm/Support/Capacity.h"
 #include "llvm/Support/raw_ostream.h"
 #include <algorithm>
 using namespace clang;
@@ -998,7 +1000,7 @@ ExternalASTSource::SetNoExternalVisibleDeclsForName(const DeclContext *DC,
     Map = DC->CreateStoredDeclsMap(Context);
 
   // Add an entry to the map for this name, if it's not already present.
-  (*Map)[Name];
+  Map->getOrCreate(Name);
 
   return DeclContext::lookup_result();
 }
@@ -1012,7 +1014,7 @@ ExternalASTSource::SetExternalVisibleDeclsForName(const DeclContext *DC,
   if (!(Map = DC->LookupPtr.getPointer()))
     Map = DC->CreateStoredDeclsMap(Context);
 
-  StoredDeclsList &List = (*Map)[Name];
+  StoredDeclsList &List = Map->getOrCreate(Name);
   for (ArrayRef<NamedDecl*>::iterator
          I = Decls.begin(), E = Decls.end(); I != E; ++I) {
     if (List.isNull())
@@ -1154,6 +1156,22 @@ static bool shouldBeHidden(NamedDecl *D) {
   return false;
 }
 
+/// collectLookupNames - Collect the distinct names that buildLookupImpl will
+/// add to the lookup data structure for DCtx.
+static void collectLookupNames(DeclContext *DCtx,
+                               llvm::DenseSet<DeclarationName> &Names) {
+  for (DeclContext::decl_iterator I = DCtx->decls_begin(),
+                                  E = DCtx->decls_end();
+       I != E; ++I) {
+    if (NamedDecl *ND = dyn_cast<NamedDecl>(*I))
+      if (ND->getDeclContext() == DCtx && !shouldBeHidden(ND))
+        Names.insert(ND->getDeclName());
+    if (DeclContext *InnerCtx = dyn_cast<DeclContext>(*I))
+      if (InnerCtx->isTransparentContext() || InnerCtx->isInlineNamespace())
+        collectLookupNames(InnerCtx, Names);
+  }
+}
+
 /// buildLookup - Build the lookup data structure with all of the
 /// declarations in this DeclContext (and any other contexts linked
 /// to it or transparent contexts nested within it) and return it.
@@ -1166,6 +1184,24 @@ StoredDeclsMap *DeclContext::buildLookup() {
 
   SmallVector<DeclContext *, 2> Contexts;
   collectAllContexts(Contexts);
+
+  // Size the table for all of the names up front, rather than rehashing it
+  // repeatedly as they are added. Namespaces such as 'std' can have many
+  // thousands of names. The table has one entry per name, so overloads and
+  // redeclarations do not count; and a table that would not outgrow its
+  // smallest out-of-line size is left to grow on demand.
+  llvm::DenseSet<DeclarationName> Names;
+  for (unsigned I = 0, N = Contexts.size(); I != N; ++I)
+    collectLookupNames(Contexts[I], Names);
+  // Keep the load factor below the 3/4 at which the map grows.
+  unsigned NumBuckets = Names.size() * 4 / 3 + 1;
+  if (NumBuckets > 64) {
+    StoredDeclsMap *Map = LookupPtr.getPointer();
+    if (!Map)
+      Map = CreateStoredDeclsMap(getParentASTContext());
+    Map->resize(NumBuckets);
+  }
+
   for (unsigned I = 0, N = Contexts.size(); I != N; ++I)
     buildLookupImpl(Contexts[I]);
 
@@ -1222,6 +1258,7 @@ DeclContext::lookup(DeclarationName Name) {
     // If a PCH/module has a result for this name, and we have a local
     // declaration, we will have imported the PCH/module result when adding the
     // local declaration or when reconciling the module.
+    Map->noteName(Name);
     std::pair<StoredDeclsMap::iterator, bool> R =
         Map->insert(std::make_pair(Name, StoredDeclsList()));
     if (!R.second)
@@ -1243,7 +1280,7 @@ DeclContext::lookup(DeclarationName Name) {
   if (LookupPtr.getInt())
     Map = buildLookup();
 
-  if (!Map)
+  if (!Map || !Map->mayContain(Name))
     return lookup_result(lookup_iterator(0), lookup_iterator(0));
 
   StoredDeclsMap::iterator I = Map->find(Name);
@@ -1401,7 +1438,7 @@ void DeclContext::makeDeclVisibleInContextImpl(NamedDecl *D, bool Internal) {
         Source->FindExternalVisibleDeclsByName(this, D->getDeclName());
 
   // Insert this declaration into the map.
-  StoredDeclsList &DeclNameEntries = (*Map)[D->getDeclName()];
+  StoredDeclsList &DeclNameEntries = Map->getOrCreate(D->getDeclName());
   if (DeclNameEntries.isNull()) {
     DeclNameEntries.setOnlyValue(D);
     return;
@@ -1456,6 +1493,45 @@ void ASTContext::ReleaseDeclContextMaps() {
   StoredDeclsMap::DestroyAll(LastSDM.getPointer(), LastSDM.getInt());
 }
 
+size_t ASTContext::getDeclContextMapsMemory(unsigned &NumMaps,
+                                            unsigned &NumNames,
+                                            unsigned &NumVectors) const {
+  NumMaps = NumNames = NumVectors = 0;
+  size_t Bytes = 0;
+  for (StoredDeclsMap *Map = LastSDM.getPointer(); Map;
+       Map = Map->Previous.getPointer()) {
+    ++NumMaps;
+    NumNames += Map->size();
+    Bytes += sizeof(StoredDeclsMap) + Map->getMemorySize() +
+             Map->getNameFilterMemorySize();
+    for (StoredDeclsMap::iterator I = Map->begin(), E = Map->end(); I != E;
+         ++I) {
+      if (StoredDeclsList::DeclsTy *Vec = I->second.getAsVector()) {
+        ++NumVectors;
+        Bytes += sizeof(*Vec) + llvm::capacity_in_bytes(*Vec);
+      }
+    }
+  }
+  return Bytes;
+}
+
+void ASTContext::PrintDeclContextMapStats() const {
+  unsigned NumMaps, NumNames, NumVectors;
+  size_t Bytes = getDeclContextMapsMemory(NumMaps, NumNames, NumVectors);
+  llvm::errs() << NumMaps << " declaration lookup tables, " << NumNames
+               << " names, " << NumVectors << " overload vectors, " << Bytes
+               << " bytes\n";
+}
+
+void StoredDeclsMap::growNameFilter() {
+  unsigned NumWords = NameFilter.size();
+  while ((size() + 1) * BitsPerName > NumWords * 64)
+    NumWords *= 2;
+  NameFilter.assign(NumWords, 0);
+  for (iterator I = begin(), E = end(); I != E; ++I)
+    setFilterBits(I->first);
+}
+
 void StoredDeclsMap::DestroyAll(StoredDeclsMap *Map, bool Dependent) {
   while (Map) {
     // Advance the iteration before we invalidate memory.
@@ -0,0 +1,506 @@
+//===--- DeclHasher.cpp - Stable hashes of declarations ---------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+//  This file implements the DeclHasher class.
+//
+//===----------------------------------------------------------------------===//
+
+#include "clang/AST/DeclHasher.h"
+#include "clang/AST/ASTContext.h"
+#include "clang/AST/Attr.h"
+#include "clang/AST/DeclCXX.h"
+#include "clang/AST/DeclTemplate.h"
+#include "clang/AST/Expr.h"
+#include "clang/AST/PrettyPrinter.h"
+#include "llvm/ADT/FoldingSet.h"
+#include "llvm/ADT/SmallPtrSet.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/Support/Allocator.h"
+#include "llvm/Support/raw_ostream.h"
+#include <algorithm>
+using namespace clang;
+
+PrintingPolicy DeclHasher::getStablePrintingPolicy(const ASTContext &Context) {
+  PrintingPolicy Policy = Context.getPrintingPolicy();
+  Policy.AnonymousTagLocations = false;
+  return Policy;
+}
+
+/// \brief Whether the given tag has neither a name nor a typedef name for
+/// linkage purposes, so that it prints the same as other such tags.
+static bool isUnnamedTag(const TagDecl *TD) {
+  return !TD->getIdentifier() && !TD->getTypedefNameForAnonDecl();
+}
+
+/// \brief The position of the given unnamed tag among the unnamed tags
+/// declared in the same context.
+static unsigned getUnnamedTagIndex(const TagDecl *TD) {
+  const DeclContext *DC = TD->getDeclContext();
+  unsigned Index = 0;
+  for (DeclContext::decl_iterator D = DC->decls_begin(),
+                               DEnd = DC->decls_end();
+       D != DEnd; ++D) {
+    const TagDecl *Other = dyn_cast<TagDecl>(*D);
+    if (!Other || !isUnnamedTag(Other))
+      continue;
+    if (Other->getCanonicalDecl() == TD->getCanonicalDecl())
+      break;
+    ++Index;
+  }
+  return Index;
+}
+
+static void profileTypeImpl(const ASTContext &Context, QualType T,
+                            llvm::FoldingSetNodeID &ID, unsigned Depth);
+
+/// \brief Tell apart the given tag from other tags that print the same,
+/// because it or one of the tags it is nested in is unnamed.
+static void profileUnnamedTag(const ASTContext &Context, const TagDecl *TD,
+                              llvm::FoldingSetNodeID &ID, unsigned Depth) {
+  for (const DeclContext *DC = TD; isa<TagDecl>(DC); DC = DC->getParent()) {
+    const TagDecl *Tag = cast<TagDecl>(DC);
+    if (!isUnnamedTag(Tag))
+      continue;
+
+    // Closure types are not members of their context, so describe them by
+    // their captures and call operator instead of their position.
+    const CXXRecordDecl *RD = dyn_cast<CXXRecordDecl>(Tag);
+    if (!RD || !RD->isLambda()) {
+      ID.AddInteger(getUnnamedTagIndex(Tag));
+      continue;
+    }
+    ID.AddInteger(RD->getLambdaManglingNumber());
+    if (Depth > 4)
+      continue;
+    for (DeclContext::decl_iterator M = RD->decls_begin(),
+                                 MEnd = RD->decls_end();
+         M != MEnd; ++M)
+      if (const ValueDecl *VD = dyn_cast<ValueDecl>(*M))
+        profileTypeImpl(Context, VD->getType(), ID, Depth + 1);
+  }
+}
+
+/// \brief Tell apart the unnamed tags that the given type refers to.
+static void profileUnnamedTags(const ASTContext &Context, QualType T,
+                               llvm::FoldingSetNodeID &ID, unsigned Depth) {
+  while (true) {
+    const Type *Ty = T.getCanonicalType().getTypePtr();
+    switch (Ty->getTypeClass()) {
+    case Type::Pointer:
+    case Type::BlockPointer:
+    case Type::LValueReference:
+    case Type::RValueReference:
+      T = Ty->getPointeeType();
+      continue;
+
+    case Type::MemberPointer: {
+      const MemberPointerType *MPT = cast<MemberPointerType>(Ty);
+      profileUnnamedTags(Context, QualType(MPT->getClass(), 0), ID, Depth);
+      T = MPT->getPointeeType();
+      continue;
+    }
+
+    case Type::ConstantArray:
+    case Type::IncompleteArray:
+    case Type::VariableArray:
+    case Type::DependentSizedArray:
+      T = cast<ArrayType>(Ty)->getElementType();
+      continue;
+
+    case Type::Complex:
+      T = cast<ComplexType>(Ty)->getElementType();
+      continue;
+
+    case Type::Vector:
+    case Type::ExtVector:
+      T = cast<VectorType>(Ty)->getElementType();
+      continue;
+
+    case Type::Atomic:
+      T = cast<AtomicType>(Ty)->getValueType();
+      continue;
+
+    case Type::FunctionProto: {
+      const FunctionProtoType *FPT = cast<FunctionProtoType>(Ty);
+      for (FunctionProtoType::arg_type_iterator A = FPT->arg_type_begin(),
+                                             AEnd = FPT->arg_type_end();
+           A != AEnd; ++A)
+        profileUnnamedTags(Context, *A, ID, Depth);
+      T = FPT->getResultType();
+      continue;
+    }
+
+    case Type::FunctionNoProto:
+      T = cast<FunctionType>(Ty)->getResultType();
+      continue;
+
+    case Type::Record:
+    case Type::Enum: {
+      const TagDecl *TD = cast<TagType>(Ty)->getDecl();
+      profileUnnamedTag(Context, TD, ID, Depth);
+      if (const ClassTemplateSpecializationDecl *Spec
+            = dyn_cast<ClassTemplateSpecializationDecl>(TD)) {
+        const TemplateArgumentList &Args = Spec->getTemplateArgs();
+        for (unsigned I = 0, N = Args.size(); I != N; ++I)
+          if (Args[I].getKind() == TemplateArgument::Type)
+            profileUnnamedTags(Context, Args[I].getAsType(), ID, Depth);
+      }
+      return;
+    }
+
+    default:
+      return;
+    }
+  }
+}
+
+static void profileTypeImpl(const ASTContext &Context, QualType T,
+                            llvm::FoldingSetNodeID &ID, unsigned Depth) {
+  T = Context.getCanonicalType(T);
+  ID.AddString(T.getAsString(DeclHasher::getStablePrintingPolicy(Context)));
+  profileUnnamedTags(Context, T, ID, Depth);
+}
+
+void DeclHasher::profileType(const ASTContext &Context, QualType T,
+                             llvm::FoldingSetNodeID &ID) {
+  profileTypeImpl(Context, T, ID, 0);
+}
+
+/// \brief Add the given statement, if any, to the profile.
+static void profileStmt(const ASTContext &Context, const Stmt *S,
+                        llvm::FoldingSetNodeID &ID) {
+  ID.AddBoolean(S != 0);
+  if (S)
+    S->ProfileStable(ID, Context);
+}
+
+void DeclHasher::profileDecl(const Decl *D, llvm::FoldingSetNodeID &ID,
+                             bool IncludeBody) {
+  ID.AddInteger(D->getKind());
+  ID.AddBoolean(D->isImplicit());
+  ID.AddInteger(D->getAccess());
+
+  if (const NamedDecl *ND = dyn_cast<NamedDecl>(D))
+    ID.AddString(ND->getQualifiedNameAsString());
+  if (const ValueDecl *VD = dyn_cast<ValueDecl>(D))
+    profileType(Context, VD->getType(), ID);
+
+  // Attributes can change the generated code, so include them as printed.
+  for (Decl::attr_iterator A = D->attr_begin(), AEnd = D->attr_end();
+       A != AEnd; ++A) {
+    std::string Spelling;
+    {
+      llvm::raw_string_ostream OS(Spelling);
+      (*A)->printPretty(OS, getStablePrintingPolicy(Context));
+    }
+    ID.AddInteger((*A)->getKind());
+    ID.AddString(Spelling);
+  }
+
+  if (const FunctionDecl *FD = dyn_cast<FunctionDecl>(D)) {
+    ID.AddInteger(FD->getStorageClass());
+    ID.AddBoolean(FD->isInlineSpecified());
+    ID.AddBoolean(FD->isDeletedAsWritten());
+    ID.AddBoolean(FD->isExplicitlyDefaulted());
+    ID.AddBoolean(FD->isConstexpr());
+    if (const CXXMethodDecl *MD = dyn_cast<CXXMethodDecl>(FD))
+      ID.AddBoolean(MD->isVirtual());
+    if (const TemplateArgumentList *Args
+          = FD->getTemplateSpecializationArgs()) {
+      std::string Spelling;
+      {
+        llvm::raw_string_ostream OS(Spelling);
+        TemplateSpecializationType::PrintTemplateArgumentList(
+            OS, Args->data(), Args->size(),
+            getStablePrintingPolicy(Context));
+      }
+      ID.AddString(Spelling);
+    }
+    if (!IncludeBody)
+      return;
+
+    if (const CXXConstructorDecl *CD = dyn_cast<CXXConstructorDecl>(FD)) {
+      ID.AddInteger(CD->getNumCtorInitializers());
+      for (CXXConstructorDecl::init_const_iterator I = CD->init_begin(),
+                                                   E = CD->init_end();
+           I != E; ++I) {
+        const CXXCtorInitializer *Init = *I;
+        if (Init->isBaseInitializer())
+          profileType(Context, QualType(Init->getBaseClass(), 0), ID);
+        else if (const FieldDecl *Member = Init->getAnyMember())
+          ID.AddString(Member->getQualifiedNameAsString());
+        profileStmt(Context, Init->getInit(), ID);
+      }
+    }
+    profileStmt(Context, FD->getBody(), ID);
+    return;
+  }
+
+  if (const VarDecl *VD = dyn_cast<VarDecl>(D)) {
+    ID.AddInteger(VD->getStorageClass());
+    ID.AddBoolean(VD->isThreadSpecified());
+    ID.AddBoolean(VD->isConstexpr());
+    profileStmt(Context, VD->getInit(), ID);
+    return;
+  }
+
+  if (const FieldDecl *FD = dyn_cast<FieldDecl>(D)) {
+    ID.AddBoolean(FD->isMutable());
+    profileStmt(Context, FD->getBitWidth(), ID);
+    profileStmt(Context, FD->getInClassInitializer(), ID);
+    return;
+  }
+
+  if (const EnumConstantDecl *ECD = dyn_cast<EnumConstantDecl>(D)) {
+    ECD->getInitVal().Profile(ID);
+    return;
+  }
+
+  if (const TypedefNameDecl *TD = dyn_cast<TypedefNameDecl>(D)) {
+    profileType(Context, TD->getUnderlyingType(), ID);
+    return;
+  }
+
+  if (const TagDecl *TD = dyn_cast<TagDecl>(D)) {
+    // The declaration kind does not tell a struct from a union or a class.
+    ID.AddInteger(TD->getTagKind());
+    TD = TD->getDefinition();
+    ID.AddBoolean(TD != 0);
+    if (!TD)
+      return;
+
+    if (const CXXRecordDecl *RD = dyn_cast<CXXRecordDecl>(TD)) {
+      ID.AddInteger(RD->getNumBases());
+      for (CXXRecordDecl::base_class_const_iterator B = RD->bases_begin(),
+                                                 BEnd = RD->bases_end();
+           B != BEnd; ++B) {
+        ID.AddBoolean(B->isVirtual());
+        ID.AddInteger(B->getAccessSpecifierAsWritten());
+        profileType(Context, B->getType(), ID);
+      }
+    }
+
+    // The members determine the layout and the virtual functions of the
+    // class; the bodies of member functions are hashed with the functions.
+    // Implicit members, such as the injected-class-name and lazily declared
+    // special members, are skipped.
+    for (DeclContext::decl_iterator M = TD->decls_begin(),
+                                 MEnd = TD->decls_end();
+         M != MEnd; ++M)
+      if (!M->isImplicit())
+        profileDecl(*M, ID, /*IncludeBody=*/false);
+    return;
+  }
+}
+
+/// \brief Reduce the given profile to a 128-bit hash.
+static DeclHash hashProfile(const llvm::FoldingSetNodeID &ID) {
+  llvm::BumpPtrAllocator Allocator;
+  llvm::FoldingSetNodeIDRef Data = ID.Intern(Allocator);
+
+  // Combine the profile with two independent 64-bit hash functions: FNV-1a
+  // over the bytes of each word, and a multiply-rotate mix over the words.
+  uint64_t Low = 0xcbf29ce484222325ULL;
+  uint64_t High = 0x9e3779b97f4a7c15ULL;
+  for (unsigned I = 0, N = Data.getSize(); I != N; ++I) {
+    uint32_t Word = Data.getData()[I];
+    for (unsigned Byte = 0; Byte != 4; ++Byte) {
+      Low ^= (Word >> (Byte * 8)) & 0xff;
+      Low *= 0x100000001b3ULL;
+    }
+    High ^= Word;
+    High *= 0xff51afd7ed558ccdULL;
+    High = (High << 31) | (High >> 33);
+  }
+  High ^= High >> 33;
+  High *= 0xc4ceb9fe1a85ec53ULL;
+  High ^= High >> 33;
+
+  return DeclHash(High, Low);
+}
+
+DeclHash DeclHasher::hash(const Decl *D) {
+  llvm::DenseMap<const Decl *, DeclHash>::iterator Known = Hashes.find(D);
+  if (Known != Hashes.end())
+    return Known->second;
+
+  llvm::FoldingSetNodeID ID;
+  profileDecl(D, ID, /*IncludeBody=*/true);
+
+  DeclHash Result = hashProfile(ID);
+  Hashes[D] = Result;
+  return Result;
+}
+
+/// \brief Whether the given tag can be hashed structurally. The profile of a
+/// template specialization does not include its template arguments, and the
+/// members of a dependent tag have no fixed layout.
+static bool isStructurallyHashable(const TagDecl *D) {
+  return !isa<ClassTemplateSpecializationDecl>(D) && !D->isDependentContext();
+}
+
+/// \brief Add the tags named by the given type to \p Tags.
+///
+/// \returns false if the type contains a type that is not understood, in
+/// which case the tags found so far are meaningless.
+static bool collectTags(QualType T, SmallVectorImpl<const TagDecl *> &Tags) {
+  while (true) {
+    const Type *Ty = T.getCanonicalType().getTypePtr();
+    switch (Ty->getTypeClass()) {
+    case Type::Builtin:
+      return true;
+
+    case Type::Pointer:
+      T = cast<PointerType>(Ty)->getPointeeType();
+      continue;
+
+    case Type::LValueReference:
+    case Type::RValueReference:
+      T = cast<ReferenceType>(Ty)->getPointeeType();
+      continue;
+
+    case Type::MemberPointer: {
+      const MemberPointerType *MPT = cast<MemberPointerType>(Ty);
+      if (!collectTags(QualType(MPT->getClass(), 0), Tags))
+        return false;
+      T = MPT->getPointeeType();
+      continue;
+    }
+
+    case Type::ConstantArray:
+    case Type::IncompleteArray:
+      T = cast<ArrayType>(Ty)->getElementType();
+      continue;
+
+    case Type::Complex:
+      T = cast<ComplexType>(Ty)->getElementType();
+      continue;
+
+    case Type::Vector:
+    case Type::ExtVector:
+      T = cast<VectorType>(Ty)->getElementType();
+      continue;
+
+    case Type::Atomic:
+      T = cast<AtomicType>(Ty)->getValueType();
+      continue;
+
+    case Type::FunctionProto: {
+      const FunctionProtoType *FPT = cast<FunctionProtoType>(Ty);
+      for (FunctionProtoType::arg_type_iterator A = FPT->arg_type_begin(),
+                                             AEnd = FPT->arg_type_end();
+           A != AEnd; ++A)
+        if (!collectTags(*A, Tags))
+          return false;
+      T = FPT->getResultType();
+      continue;
+    }
+
+    case Type::FunctionNoProto:
+      T = cast<FunctionType>(Ty)->getResultType();
+      continue;
+
+    case Type::Record:
+    case Type::Enum:
+      Tags.push_back(cast<TagType>(Ty)->getDecl());
+      return true;
+
+    default:
+      return false;
+    }
+  }
+}
+
+bool DeclHasher::hashStructure(const TagDecl *D, DeclHash &Hash) {
+  const TagDecl *Def = D->getDefinition();
+  if (!Def)
+    return false;
+
+  llvm::DenseMap<const TagDecl *, std::pair<bool, DeclHash> >::iterator Known
+    = StructureHashes.find(Def);
+  if (Known != StructureHashes.end()) {
+    Hash = Known->second.second;
+    return Known->second.first;
+  }
+
+  // The profile of a tag covers its own members, but only the names of the
+  // tags that they refer to; a field of type 'struct T *' hashes the same
+  // whatever the definition of T. Collect the hashes of every tag reachable
+  // through fields, bases and nested tags, so that two tags with the same
+  // structural hash have the same definitions all the way down.
+  llvm::SmallPtrSet<const TagDecl *, 16> Visited;
+  SmallVector<const TagDecl *, 16> Worklist;
+  SmallVector<std::pair<uint64_t, uint64_t>, 16> Reachable;
+  bool Hashable = true;
+  Worklist.push_back(Def);
+  while (Hashable && !Worklist.empty()) {
+    const TagDecl *Tag = Worklist.pop_back_val();
+    if (const TagDecl *TagDef = Tag->getDefinition())
+      Tag = TagDef;
+    if (!Visited.insert(Tag))
+      continue;
+    if (!isStructurallyHashable(Tag)) {
+      Hashable = false;
+      break;
+    }
+
+    DeclHash TagHash = hash(Tag);
+    Reachable.push_back(std::make_pair(TagHash.High, TagHash.Low));
+    if (!Tag->isCompleteDefinition())
+      continue;
+
+    // The underlying type of an enum is not part of its profile.
+    if (const EnumDecl *ED = dyn_cast<EnumDecl>(Tag)) {
+      llvm::FoldingSetNodeID ID;
+      ID.AddInteger(TagHash.High);
+      ID.AddInteger(TagHash.Low);
+      profileType(Context, ED->getIntegerType(), ID);
+      DeclHash EnumHash = hashProfile(ID);
+      Reachable.back() = std::make_pair(EnumHash.High, EnumHash.Low);
+      continue;
+    }
+
+    if (const CXXRecordDecl *RD = dyn_cast<CXXRecordDecl>(Tag))
+      for (CXXRecordDecl::base_class_const_iterator B = RD->bases_begin(),
+                                                 BEnd = RD->bases_end();
+           B != BEnd && Hashable; ++B)
+        Hashable = collectTags(B->getType(), Worklist);
+
+    for (DeclContext::decl_iterator M = Tag->decls_begin(),
+                                 MEnd = Tag->decls_end();
+         M != MEnd && Hashable; ++M) {
+      if (const FieldDecl *FD = dyn_cast<FieldDecl>(*M))
+        Hashable = collectTags(FD->getType(), Worklist);
+      else if (const TagDecl *Nested = dyn_cast<TagDecl>(*M))
+        Worklist.push_back(Nested);
+    }
+  }
+
+  if (Hashable) {
+    // The set of reachable tags does not depend on the order in which they
+    // were found, but which of them is the root does.
+    std::pair<uint64_t, uint64_t> Root = Reachable.front();
+    std::sort(Reachable.begin(), Reachable.end());
+    Reachable.erase(std::unique(Reachable.begin(), Reachable.end()),
+                    Reachable.end());
+
+    llvm::FoldingSetNodeID ID;
+    ID.AddInteger(Root.first);
+    ID.AddInteger(Root.second);
+    ID.AddInteger(Reachable.size());
+    for (unsigned I = 0, N = Reachable.size(); I != N; ++I) {
+      ID.AddInteger(Reachable[I].first);
+      ID.AddInteger(Reachable[I].second);
+    }
+    Hash = hashProfile(ID);
+  }
+
+  StructureHashes[Def] = std::make_pair(Hashable, Hash);
+  return Hashable;
+}
@@ -1267,6 +1267,26 @@ IdentifierInfo *OffsetOfExpr::OffsetOfNode::getFieldName() const {
   return reinterpret_cast<IdentifierInfo *> (Data & ~(uintptr_t)Mask);
 }
 
+/// \brief Whether a DeclarationNameLoc carries any information for the
+/// given name.
+static bool hasDeclarationNameLoc(DeclarationName Name) {
+  switch (Name.getNameKind()) {
+  case DeclarationName::CXXConstructorName:
+  case DeclarationName::CXXDestructorName:
+  case DeclarationName::CXXConversionFunctionName:
+  case DeclarationName::CXXOperatorName:
+  case DeclarationName::CXXLiteralOperatorName:
+    return true;
+  case DeclarationName::Identifier:
+  case DeclarationName::ObjCZeroArgSelector:
+  case DeclarationName::ObjCOneArgSelector:
+  case DeclarationName::ObjCMultiArgSelector:
+  case DeclarationName::CXXUsingDirective:
+    return false;
+  }
+  llvm_unreachable("Invalid DeclarationName kind!");
+}
+
 MemberExpr *MemberExpr::Create(ASTContext &C, Expr *base, bool isarrow,
                                NestedNameSpecifierLoc QualifierLoc,
                                SourceLocation TemplateKWLoc,
@@ -1277,8 +1297,13 @@ MemberExpr *MemberExpr::Create(ASTContext &C, Expr *base, bool isarrow,
                                QualType ty,
                                ExprValueKind vk,
                                ExprObjectKind ok) {
+  assert(memberdecl->getDeclName() == nameinfo.getName());
   std::size_t Size = sizeof(MemberExpr);
 
+  bool hasDNLoc = hasDeclarationNameLoc(nameinfo.getName());
+  if (hasDNLoc)
+    Size += sizeof(DeclarationNameLoc);
+
   bool hasQualOrFound = (QualifierLoc ||
                          founddecl.getDecl() != memberdecl ||
                          founddecl.getAccess() != memberdecl->getAccess());
@@ -1291,8 +1316,13 @@ MemberExpr *MemberExpr::Create(ASTContext &C, Expr *base, bool isarrow,
     Size += ASTTemplateKWAndArgsInfo::sizeFor(0);
 
   void *Mem = C.Allocate(Size, llvm::alignOf<MemberExpr>());
-  MemberExpr *E = new (Mem) MemberExpr(base, isarrow, memberdecl, nameinfo,
-                                       ty, vk, ok);
+  MemberExpr *E = new (Mem) MemberExpr(base, isarrow, memberdecl,
+                                       nameinfo.getLoc(), ty, vk, ok);
+
+  if (hasDNLoc) {
+    E->HasMemberDNLoc = true;
+    *E->getMemberDNLoc() = nameinfo.getInfo();
+  }
 
   if (hasQualOrFound) {
     // FIXME: Wrong. We should be looking at the member declaration we found.
@@ -33,6 +33,7 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include "ConstexprCallCache.h"
 #include "clang/AST/APValue.h"
 #include "clang/AST/ASTContext.h"
 #include "clang/AST/ASTDiagnostic.h"
@@ -376,6 +377,10 @@ namespace {
     /// declaration whose initializer is being evaluated, if any.
     APValue *EvaluatingDeclValue;
 
+    /// ReadEvaluatingDecl - Whether the in-flight value of EvaluatingDecl has
+    /// been read. Calls that read it cannot be memoized.
+    bool ReadEvaluatingDecl;
+
     /// HasActiveDiagnostic - Was the previous diagnostic stored? If so, further
     /// notes attached to it will also be stored, otherwise they will not be.
     bool HasActiveDiagnostic;
@@ -392,7 +397,8 @@ namespace {
       : Ctx(const_cast<ASTContext&>(C)), EvalStatus(S), CurrentCall(0),
         CallStackDepth(0), NextCallIndex(1),
         BottomFrame(*this, SourceLocation(), 0, 0, 0),
-        EvaluatingDecl(0), EvaluatingDeclValue(0), HasActiveDiagnostic(false),
+        EvaluatingDecl(0), EvaluatingDeclValue(0), ReadEvaluatingDecl(false),
+        HasActiveDiagnostic(false),
         CheckingPotentialConstantExpression(false),
         IntOverflowCheckMode(OverflowCheckMode) {}
 
@@ -1427,9 +1433,13 @@ static bool HandleLValueComplexElement(EvalInfo &Info, const Expr *E,
 }
 
 /// Try to evaluate the initializer for a variable declaration.
+///
+/// On success, \p Result points to the value of the variable, which is owned
+/// by the variable, the call frame or the evaluation, and must not be
+/// modified.
 static bool EvaluateVarDeclInit(EvalInfo &Info, const Expr *E,
-                                const VarDecl *VD,
-                                CallStackFrame *Frame, APValue &Result) {
+                                const VarDecl *VD, CallStackFrame *Frame,
+                                const APValue *&Result) {
   // If this is a parameter to an active constexpr function call, perform
   // argument substitution.
   if (const ParmVarDecl *PVD = dyn_cast<ParmVarDecl>(VD)) {
@@ -1441,7 +1451,7 @@ static bool EvaluateVarDeclInit(EvalInfo &Info, const Expr *E,
       Info.Diag(E, diag::note_invalid_subexpr_in_const_expr);
       return false;
     }
-    Result = Frame->Arguments[PVD->getFunctionScopeIndex()];
+    Result = &Frame->Arguments[PVD->getFunctionScopeIndex()];
     return true;
   }
 
@@ -1458,8 +1468,9 @@ static bool EvaluateVarDeclInit(EvalInfo &Info, const Expr *E,
   // If we're currently evaluating the initializer of this declaration, use that
   // in-flight value.
   if (Info.EvaluatingDecl == VD) {
-    Result = *Info.EvaluatingDeclValue;
-    return !Result.isUninit();
+    Info.ReadEvaluatingDecl = true;
+    Result = Info.EvaluatingDeclValue;
+    return !Result->isUninit();
   }
 
   // Never evaluate the initializer of a weak variable. We can't be sure that
@@ -1485,7 +1496,7 @@ static bool EvaluateVarDeclInit(EvalInfo &Info, const Expr *E,
     Info.addNotes(Notes);
   }
 
-  Result = *VD->getEvaluatedValue();
+  Result = VD->getEvaluatedValue();
   return true;
 }
 
@@ -1527,10 +1538,13 @@ static APSInt ExtractStringLiteralCharacter(EvalInfo &Info, const Expr *Lit,
   return Value;
 }
 
-/// Extract the designated sub-object of an rvalue.
+/// Extract the designated sub-object of an rvalue into \p Result, which may be
+/// \p Obj itself. Only the sub-object is copied, so that reading one element
+/// of a large array does not copy the whole array.
 static bool ExtractSubobject(EvalInfo &Info, const Expr *E,
-                             APValue &Obj, QualType ObjType,
-                             const SubobjectDesignator &Sub, QualType SubType) {
+                             const APValue &Obj, QualType ObjType,
+                             const SubobjectDesignator &Sub, QualType SubType,
+                             APValue &Result) {
   if (Sub.Invalid)
     // A diagnostic will have already been produced.
     return false;
@@ -1540,13 +1554,15 @@ static bool ExtractSubobject(EvalInfo &Info, const Expr *E,
                 (unsigned)diag::note_invalid_subexpr_in_const_expr);
     return false;
   }
-  if (Sub.Entries.empty())
+  if (Sub.Entries.empty()) {
+    Result = Obj;
     return true;
+  }
   if (Info.CheckingPotentialConstantExpression && Obj.isUninit())
     // This object might be initialized later.
     return false;
 
-  APValue *O = &Obj;
+  const APValue *O = &Obj;
   // Walk the designator's path to find the subobject.
   for (unsigned I = 0, N = Sub.Entries.size(); I != N; ++I) {
     if (ObjType->isArrayType()) {
@@ -1567,7 +1583,7 @@ static bool ExtractSubobject(EvalInfo &Info, const Expr *E,
       if (O->isLValue()) {
         assert(I == N - 1 && "extracting subobject of character?");
         assert(!O->hasLValuePath() || O->getLValuePath().empty());
-        Obj = APValue(ExtractStringLiteralCharacter(
+        Result = APValue(ExtractStringLiteralCharacter(
           Info, O->getLValueBase().get<const Expr*>(), Index, SubType));
         return true;
       } else if (O->getArrayInitializedElts() > Index)
@@ -1586,12 +1602,12 @@ static bool ExtractSubobject(EvalInfo &Info, const Expr *E,
       }
       assert(I == N - 1 && "extracting subobject of scalar?");
       if (O->isComplexInt()) {
-        Obj = APValue(Index ? O->getComplexIntImag()
-                            : O->getComplexIntReal());
+        Result = APValue(Index ? O->getComplexIntImag()
+                               : O->getComplexIntReal());
       } else {
         assert(O->isComplexFloat());
-        Obj = APValue(Index ? O->getComplexFloatImag()
-                            : O->getComplexFloatReal());
+        Result = APValue(Index ? O->getComplexFloatImag()
+                               : O->getComplexFloatReal());
       }
       return true;
     } else if (const FieldDecl *Field = getAsField(Sub.Entries[I])) {
@@ -1643,13 +1659,9 @@ static bool ExtractSubobject(EvalInfo &Info, const Expr *E,
     }
   }
 
-  // This may look super-stupid, but it serves an important purpose: if we just
-  // swapped Obj and *O, we'd create an object which had itself as a subobject.
-  // To avoid the leak, we ensure that Tmp ends up owning the original complete
-  // object, which is destroyed by Tmp's destructor.
-  APValue Tmp;
-  O->swap(Tmp);
-  Obj.swap(Tmp);
+  // The assignment copies *O before releasing the old value of Result, so this
+  // is correct even if O is a subobject of Result.
+  Result = *O;
   return true;
 }
 
@@ -1822,26 +1834,28 @@ static bool HandleLValueToRValueConversion(EvalInfo &Info, const Expr *Conv,
       }
     }
 
-    if (!EvaluateVarDeclInit(Info, Conv, VD, Frame, RVal))
+    const APValue *Value;
+    if (!EvaluateVarDeclInit(Info, Conv, VD, Frame, Value))
       return false;
 
     if (isa<ParmVarDecl>(VD) || !VD->getAnyInitializer()->isLValue())
-      return ExtractSubobject(Info, Conv, RVal, VT, LVal.Designator, Type);
+      return ExtractSubobject(Info, Conv, *Value, VT, LVal.Designator, Type,
+                              RVal);
 
     // The declaration was initialized by an lvalue, with no lvalue-to-rvalue
     // conversion. This happens when the declaration and the lvalue should be
     // considered synonymous, for instance when initializing an array of char
     // from a string literal. Continue as if the initializer lvalue was the
     // value we were originally given.
-    assert(RVal.getLValueOffset().isZero() &&
+    assert(Value->getLValueOffset().isZero() &&
            "offset for lvalue init of non-reference");
-    Base = RVal.getLValueBase().get<const Expr*>();
+    Base = Value->getLValueBase().get<const Expr*>();
 
-    if (unsigned CallIndex = RVal.getLValueCallIndex()) {
+    if (unsigned CallIndex = Value->getLValueCallIndex()) {
       Frame = Info.getCallFrame(CallIndex);
       if (!Frame) {
         Info.Diag(Conv, diag::note_constexpr_lifetime_ended, 1) << !Base;
-        NoteLValueLocation(Info, RVal.getLValueBase());
+        NoteLValueLocation(Info, Value->getLValueBase());
         return false;
       }
     } else {
@@ -1860,10 +1874,11 @@ static bool HandleLValueToRValueConversion(EvalInfo &Info, const Expr *Conv,
     return false;
   }
 
+  const APValue *Obj = &RVal;
   if (Frame) {
     // If this is a temporary expression with a nontrivial initializer, grab the
     // value from the relevant stack frame.
-    RVal = Frame->Temporaries[Base];
+    Obj = &Frame->Temporaries[Base];
   } else if (const CompoundLiteralExpr *CLE
              = dyn_cast<CompoundLiteralExpr>(Base)) {
     // In C99, a CompoundLiteralExpr is an lvalue, and we defer evaluating the
@@ -1882,8 +1897,8 @@ static bool HandleLValueToRValueConversion(EvalInfo &Info, const Expr *Conv,
     return false;
   }
 
-  return ExtractSubobject(Info, Conv, RVal, Base->getType(), LVal.Designator,
-                          Type);
+  return ExtractSubobject(Info, Conv, *Obj, Base->getType(), LVal.Designator,
+                          Type, RVal);
 }
 
 /// Build an lvalue for the object argument of a member function call.
@@ -2152,6 +2167,38 @@ static bool EvaluateArgs(ArrayRef<const Expr*> Args, ArgVector &ArgValues,
   return Success;
 }
 
+/// Determine whether the result of a call can be looked up in, and added to,
+/// the ASTContext's cache of constexpr call results, and if so, compute its
+/// key.
+///
+/// Only calls without a 'this' object whose arguments are all integers or
+/// floating-point values are memoized: the result of such a call can only
+/// depend on the argument values. The evaluation must also still be a
+/// constant expression, so that a result which was only folded is never
+/// recorded.
+static bool getConstexprCallKey(EvalInfo &Info, const FunctionDecl *Callee,
+                                const LValue *This,
+                                ArrayRef<APValue> ArgValues,
+                                llvm::FoldingSetNodeID &ID) {
+  if (This || Info.CheckingPotentialConstantExpression ||
+      !Info.EvalStatus.Diag || !Info.EvalStatus.Diag->empty() ||
+      Info.EvalStatus.HasSideEffects)
+    return false;
+
+  ID.AddPointer(Callee->getCanonicalDecl());
+  for (unsigned I = 0, N = ArgValues.size(); I != N; ++I) {
+    const APValue &Arg = ArgValues[I];
+    ID.AddInteger(Arg.getKind());
+    if (Arg.isInt())
+      Arg.getInt().Profile(ID);
+    else if (Arg.isFloat())
+      Arg.getFloat().Profile(ID);
+    else
+      return false;
+  }
+  return true;
+}
+
 /// Evaluate a function call.
 static bool HandleFunctionCall(SourceLocation CallLoc,
                                const FunctionDecl *Callee, const LValue *This,
@@ -2164,8 +2211,33 @@ static bool HandleFunctionCall(SourceLocation CallLoc,
   if (!Info.CheckCallLimit(CallLoc))
     return false;
 
-  CallStackFrame Frame(Info, CallLoc, Callee, This, ArgValues.data());
-  return EvaluateStmt(Result, Info, Body) == ESR_Returned;
+  // Constexpr functions are often called again with the same arguments, for
+  // instance by recursive functions and by lookup tables built at compile
+  // time, so reuse earlier results where we can.
+  llvm::FoldingSetNodeID ID;
+  if (!getConstexprCallKey(Info, Callee, This, ArgValues, ID)) {
+    CallStackFrame Frame(Info, CallLoc, Callee, This, ArgValues.data());
+    return EvaluateStmt(Result, Info, Body) == ESR_Returned;
+  }
+
+  ConstexprCallCache &Cache = Info.Ctx.getConstexprCallCache();
+  if (const APValue *Cached = Cache.lookup(ID)) {
+    Result = *Cached;
+    return true;
+  }
+
+  bool ReadEvaluatingDecl = Info.ReadEvaluatingDecl;
+  Info.ReadEvaluatingDecl = false;
+  bool Success;
+  {
+    CallStackFrame Frame(Info, CallLoc, Callee, This, ArgValues.data());
+    Success = EvaluateStmt(Result, Info, Body) == ESR_Returned;
+  }
+  if (Success && !Info.ReadEvaluatingDecl && Info.EvalStatus.Diag->empty() &&
+      !Info.EvalStatus.HasSideEffects && (Result.isInt() || Result.isFloat()))
+    Cache.insert(ID, Result);
+  Info.ReadEvaluatingDecl |= ReadEvaluatingDecl;
+  return Success;
 }
 
 /// Evaluate a constructor call.
@@ -2609,7 +2681,8 @@ public:
     SubobjectDesignator Designator(BaseTy);
     Designator.addDeclUnchecked(FD);
 
-    return ExtractSubobject(Info, E, Val, BaseTy, Designator, E->getType()) &&
+    return ExtractSubobject(Info, E, Val, BaseTy, Designator, E->getType(),
+                            Val) &&
            DerivedSuccess(Val, E);
   }
 
@@ -2857,10 +2930,10 @@ bool LValueExprEvaluator::VisitVarDecl(const Expr *E, const VarDecl *VD) {
     return Success(VD);
   }
 
-  APValue V;
+  const APValue *V;
   if (!EvaluateVarDeclInit(Info, E, VD, Info.CurrentCall, V))
     return false;
-  return Success(V, E);
+  return Success(*V, E);
 }
 
 bool LValueExprEvaluator::VisitMaterializeTemporaryExpr(
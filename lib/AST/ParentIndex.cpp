@@ -0,0 +1,142 @@
+//===--- ParentIndex.cpp - Parents of all nodes in a translation unit -----===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+//  This file implements the ParentIndex class.
+//
+//===----------------------------------------------------------------------===//
+
+#include "clang/AST/ParentIndex.h"
+#include "clang/AST/RecursiveASTVisitor.h"
+#include "llvm/ADT/SmallVector.h"
+#include <algorithm>
+using namespace clang;
+
+const ParentIndex::NodeID ParentIndex::InvalidNodeID;
+
+namespace clang {
+
+/// \brief A \c RecursiveASTVisitor that assigns IDs to all nodes of a
+/// translation unit and collects the edges to their parents.
+///
+/// Note that the relationship described here is purely in terms of AST
+/// traversal - there are other relationships (for example declaration context)
+/// in the AST that are better modeled by special matchers.
+///
+/// FIXME: Currently only builds up the index using \c Stmt and \c Decl nodes.
+class ParentIndexBuilder : public RecursiveASTVisitor<ParentIndexBuilder> {
+  typedef RecursiveASTVisitor<ParentIndexBuilder> VisitorBase;
+  typedef ParentIndex::NodeID NodeID;
+
+  ParentIndex &Index;
+
+  /// \brief The (child, parent) pairs found by the traversal, in the order in
+  /// which they were found.
+  std::vector<std::pair<NodeID, NodeID> > Edges;
+
+  SmallVector<NodeID, 16> ParentStack;
+
+public:
+  explicit ParentIndexBuilder(ParentIndex &Index) : Index(Index) {}
+
+  void finish();
+
+  bool shouldVisitTemplateInstantiations() const {
+    return true;
+  }
+  bool shouldVisitImplicitCode() const {
+    return true;
+  }
+  // Disables data recursion. We intercept Traverse* methods in the RAV, which
+  // are not triggered during data recursion.
+  bool shouldUseDataRecursionFor(clang::Stmt *S) const {
+    return false;
+  }
+
+  template <typename T>
+  bool TraverseNode(T *Node, bool(VisitorBase:: *traverse) (T *)) {
+    if (Node == NULL)
+      return true;
+
+    std::pair<llvm::DenseMap<const void *, NodeID>::iterator, bool> Inserted
+      = Index.IDs.insert(std::make_pair(Node, NodeID(Index.Nodes.size())));
+    NodeID ID = Inserted.first->second;
+    if (Inserted.second)
+      Index.Nodes.push_back(ast_type_traits::DynTypedNode::create(*Node));
+
+    // Nodes in templates are visited once for each instantiation, so the same
+    // edge can be found several times; finish() removes the duplicates.
+    if (!ParentStack.empty())
+      Edges.push_back(std::make_pair(ID, ParentStack.back()));
+    ParentStack.push_back(ID);
+    bool Result = (this ->* traverse) (Node);
+    ParentStack.pop_back();
+    return Result;
+  }
+
+  bool TraverseDecl(Decl *DeclNode) {
+    return TraverseNode(DeclNode, &VisitorBase::TraverseDecl);
+  }
+
+  bool TraverseStmt(Stmt *StmtNode) {
+    return TraverseNode(StmtNode, &VisitorBase::TraverseStmt);
+  }
+};
+
+} // end namespace clang
+
+/// \brief Lay out the collected edges in the index, grouped by child.
+void ParentIndexBuilder::finish() {
+  unsigned NumNodes = Index.Nodes.size();
+
+  // Count the edges of each node, then place them with a counting sort so that
+  // the parents of each node keep the order in which they were found.
+  std::vector<unsigned> &Start = Index.ParentStart;
+  Start.assign(NumNodes + 1, 0);
+  for (unsigned I = 0, N = Edges.size(); I != N; ++I)
+    ++Start[Edges[I].first + 1];
+  for (unsigned I = 0; I != NumNodes; ++I)
+    Start[I + 1] += Start[I];
+
+  std::vector<NodeID> Sorted(Edges.size());
+  std::vector<unsigned> Next(Start.begin(), Start.end() - 1);
+  for (unsigned I = 0, N = Edges.size(); I != N; ++I)
+    Sorted[Next[Edges[I].first]++] = Edges[I].second;
+  std::vector<std::pair<NodeID, NodeID> >().swap(Edges);
+
+  // Remove duplicate parents. Almost every node has a single parent, so the
+  // quadratic scan is cheaper than sorting each group.
+  std::vector<NodeID> &Parents = Index.Parents;
+  Parents.reserve(Sorted.size());
+  unsigned Begin = 0;
+  for (unsigned I = 0; I != NumNodes; ++I) {
+    unsigned End = Start[I + 1];
+    Start[I] = Parents.size();
+    for (unsigned J = Begin; J != End; ++J)
+      if (std::find(Parents.begin() + Start[I], Parents.end(), Sorted[J]) ==
+          Parents.end())
+        Parents.push_back(Sorted[J]);
+    Begin = End;
+  }
+  Start[NumNodes] = Parents.size();
+}
+
+ParentIndex *ParentIndex::build(TranslationUnitDecl &TU) {
+  ParentIndex *Index = new ParentIndex;
+  ParentIndexBuilder Builder(*Index);
+  Builder.TraverseDecl(&TU);
+  Builder.finish();
+  return Index;
+}
+
+size_t ParentIndex::getMemorySize() const {
+  return IDs.getMemorySize() +
+         Nodes.capacity() * sizeof(ast_type_traits::DynTypedNode) +
+         ParentStart.capacity() * sizeof(unsigned) +
+         Parents.capacity() * sizeof(NodeID);
+}
@@ -13,6 +13,7 @@
 //===----------------------------------------------------------------------===//
 #include "clang/AST/ASTContext.h"
 #include "clang/AST/DeclCXX.h"
+#include "clang/AST/DeclHasher.h"
 #include "clang/AST/DeclObjC.h"
 #include "clang/AST/DeclTemplate.h"
 #include "clang/AST/Expr.h"
@@ -20,6 +21,7 @@
 #include "clang/AST/ExprObjC.h"
 #include "clang/AST/StmtVisitor.h"
 #include "llvm/ADT/FoldingSet.h"
+#include "llvm/Support/raw_ostream.h"
 using namespace clang;
 
 namespace {
@@ -28,10 +30,16 @@ namespace {
     const ASTContext &Context;
     bool Canonical;
 
+    /// \brief Whether declarations, types and names are identified by their
+    /// spelling rather than their address, so that the profile is the same
+    /// in every compilation of the same code.
+    bool Stable;
+
   public:
     StmtProfiler(llvm::FoldingSetNodeID &ID, const ASTContext &Context,
-                 bool Canonical)
-      : ID(ID), Context(Context), Canonical(Canonical) { }
+                 bool Canonical, bool Stable = false)
+      : ID(ID), Context(Context), Canonical(Canonical || Stable),
+        Stable(Stable) { }
 
     void VisitStmt(const Stmt *S);
 
@@ -322,7 +330,10 @@ void StmtProfiler::VisitOffsetOfExpr(const OffsetOfExpr *S) {
       break;
 
     case OffsetOfExpr::OffsetOfNode::Identifier:
-      ID.AddPointer(ON.getFieldName());
+      if (Stable)
+        ID.AddString(ON.getFieldName()->getName());
+      else
+        ID.AddPointer(ON.getFieldName());
       break;
         
     case OffsetOfExpr::OffsetOfNode::Base:
@@ -1119,6 +1130,19 @@ void StmtProfiler::VisitDecl(const Decl *D) {
     }
   }
 
+  if (Stable && D) {
+    if (const NamedDecl *ND = dyn_cast<NamedDecl>(D)) {
+      ID.AddString(ND->getQualifiedNameAsString());
+      if (const ValueDecl *VD = dyn_cast<ValueDecl>(ND))
+        VisitType(VD->getType());
+    } else if (const BlockDecl *BD = dyn_cast<BlockDecl>(D)) {
+      // A block's body is not a child of the BlockExpr.
+      if (BD->getBody())
+        Visit(BD->getBody());
+    }
+    return;
+  }
+
   ID.AddPointer(D? D->getCanonicalDecl() : 0);
 }
 
@@ -1126,16 +1150,37 @@ void StmtProfiler::VisitType(QualType T) {
   if (Canonical)
     T = Context.getCanonicalType(T);
 
+  if (Stable) {
+    DeclHasher::profileType(Context, T, ID);
+    return;
+  }
+
   ID.AddPointer(T.getAsOpaquePtr());
 }
 
 void StmtProfiler::VisitName(DeclarationName Name) {
+  if (Stable) {
+    ID.AddString(Name.getAsString());
+    return;
+  }
+
   ID.AddPointer(Name.getAsOpaquePtr());
 }
 
 void StmtProfiler::VisitNestedNameSpecifier(NestedNameSpecifier *NNS) {
   if (Canonical)
     NNS = Context.getCanonicalNestedNameSpecifier(NNS);
+
+  if (Stable) {
+    std::string Spelling;
+    if (NNS) {
+      llvm::raw_string_ostream OS(Spelling);
+      NNS->print(OS, DeclHasher::getStablePrintingPolicy(Context));
+    }
+    ID.AddString(Spelling);
+    return;
+  }
+
   ID.AddPointer(NNS);
 }
 
@@ -1143,6 +1188,16 @@ void StmtProfiler::VisitTemplateName(TemplateName Name) {
   if (Canonical)
     Name = Context.getCanonicalTemplateName(Name);
 
+  if (Stable) {
+    std::string Spelling;
+    {
+      llvm::raw_string_ostream OS(Spelling);
+      Name.print(OS, DeclHasher::getStablePrintingPolicy(Context));
+    }
+    ID.AddString(Spelling);
+    return;
+  }
+
   Name.Profile(ID);
 }
 
@@ -1199,3 +1254,9 @@ void Stmt::Profile(llvm::FoldingSetNodeID &ID, const ASTContext &Context,
   StmtProfiler Profiler(ID, Context, Canonical);
   Profiler.Visit(this);
 }
+
+void Stmt::ProfileStable(llvm::FoldingSetNodeID &ID,
+                         const ASTContext &Context) const {
+  StmtProfiler Profiler(ID, Context, /*Canonical=*/true, /*Stable=*/true);
+  Profiler.Visit(this);
+}
@@ -1593,7 +1593,7 @@ FunctionProtoType::FunctionProtoType(QualType result, ArrayRef<QualType> args,
     ExceptionSpecType(epi.ExceptionSpecType),
     HasAnyConsumedArgs(epi.ConsumedArguments != 0),
     Variadic(epi.Variadic), HasTrailingReturn(epi.HasTrailingReturn),
-    RefQualifier(epi.RefQualifier)
+    RefQualifier(epi.RefQualifier), ProfileHash(0)
 {
   assert(NumArgs == args.size() && "function has too many parameters");
 
@@ -1751,6 +1751,27 @@ void FunctionProtoType::Profile(llvm::FoldingSetNodeID &ID,
           Ctx);
 }
 
+/// \brief Determine whether a type in a uniquing table has the profile being
+/// looked up, rejecting it by the hash of its profile when possible.
+template <typename T>
+static bool equalsUniquedType(T &X, const llvm::FoldingSetNodeID &ID,
+                              unsigned IDHash, llvm::FoldingSetNodeID &TempID,
+                              ASTContext &Context) {
+  ++ASTContext::NumUniquingCandidates;
+  if (X.getProfileHash() != IDHash) {
+    ++ASTContext::NumUniquingCandidatesRejectedByHash;
+    return false;
+  }
+  X.Profile(TempID, Context);
+  return TempID == ID;
+}
+
+bool llvm::ContextualFoldingSetTrait<FunctionProtoType, ASTContext&>::Equals(
+    FunctionProtoType &X, const FoldingSetNodeID &ID, unsigned IDHash,
+    FoldingSetNodeID &TempID, ASTContext &Context) {
+  return equalsUniquedType(X, ID, IDHash, TempID, Context);
+}
+
 QualType TypedefType::desugar() const {
   return getDecl()->getUnderlyingType();
 }
@@ -1930,7 +1951,8 @@ TemplateSpecializationType(TemplateName T,
                        : Canon->isInstantiationDependentType(),
          false,
          T.containsUnexpandedParameterPack()),
-    Template(T), NumArgs(NumArgs), TypeAlias(!AliasedType.isNull()) {
+    Template(T), NumArgs(NumArgs), TypeAlias(!AliasedType.isNull()),
+    ProfileHash(0) {
   assert(!T.getAsDependentTemplateName() && 
          "Use DependentTemplateSpecializationType for dependent template-name");
   assert((T.getKind() == TemplateName::Template ||
@@ -1988,6 +2010,12 @@ TemplateSpecializationType::Profile(llvm::FoldingSetNodeID &ID,
     Args[Idx].Profile(ID, Context);
 }
 
+bool llvm::ContextualFoldingSetTrait<TemplateSpecializationType, ASTContext&>::
+Equals(TemplateSpecializationType &X, const FoldingSetNodeID &ID,
+       unsigned IDHash, FoldingSetNodeID &TempID, ASTContext &Context) {
+  return equalsUniquedType(X, ID, IDHash, TempID, Context);
+}
+
 QualType
 QualifierCollector::apply(const ASTContext &Context, QualType QT) const {
   if (!hasNonFastQualifiers())
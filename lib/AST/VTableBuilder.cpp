@@ -2406,40 +2406,140 @@ static VTableLayout *CreateVTableLayout(const VTableBuilder &Builder) {
                           Builder.isMicrosoftABI());
 }
 
-void VTableContext::ComputeVTableRelatedInformation(const CXXRecordDecl *RD) {
-  const VTableLayout *&Entry = VTableLayouts[RD];
+bool VTableContext::ComputeSingleInheritanceVTableLayout(
+                                                      const CXXRecordDecl *RD,
+                                                      VTableLayoutInfo &Info) {
+  if (isMicrosoftABI() || RD->getNumVBases())
+    return false;
 
-  // Check if we've computed this information before.
-  if (Entry)
+  // Collect the chain of primary bases that share the vtable of the class.
+  // Any class along it with more than one base may need secondary vtables.
+  SmallVector<const CXXRecordDecl *, 8> Chain;
+  for (const CXXRecordDecl *Class = RD; Class; ) {
+    Chain.push_back(Class);
+
+    // The method overrides a base method without a return adjustment only if
+    // it shares its vtable index; otherwise the base entry needs a thunk.
+    for (CXXRecordDecl::method_iterator I = Class->method_begin(),
+         E = Class->method_end(); I != E; ++I) {
+      const CXXMethodDecl *MD = *I;
+      if (!MD->isVirtual())
+        continue;
+
+      OverriddenMethodsSetTy OverriddenMethods;
+      ComputeAllOverriddenMethods(MD, OverriddenMethods);
+      for (OverriddenMethodsSetTy::const_iterator O = OverriddenMethods.begin(),
+           OE = OverriddenMethods.end(); O != OE; ++O) {
+        if (!ComputeReturnAdjustmentBaseOffset(Context, MD, *O).isEmpty())
+          return false;
+      }
+    }
+
+    if (Class->getNumBases() > 1)
+      return false;
+    if (!Class->getNumBases())
+      break;
+
+    const CXXRecordDecl *BaseDecl =
+      Class->bases_begin()->getType()->getAsCXXRecordDecl();
+    if (!BaseDecl->isDynamicClass())
+      break;
+    if (Context.getASTRecordLayout(Class).getPrimaryBase() != BaseDecl)
+      return false;
+    Class = BaseDecl;
+  }
+
+  Info.Components.push_back(
+    VTableComponent::MakeOffsetToTop(CharUnits::Zero()));
+  Info.Components.push_back(VTableComponent::MakeRTTI(RD));
+  uint64_t AddressPoint = Info.Components.size();
+  Info.Components.resize(AddressPoint + getNumVirtualFunctionPointers(RD));
+
+  // Fill in the function pointers from the root of the chain down, so that
+  // each entry ends up holding its final overrider.
+  for (unsigned I = Chain.size(); I != 0; --I) {
+    const CXXRecordDecl *Class = Chain[I - 1];
+    for (CXXRecordDecl::method_iterator M = Class->method_begin(),
+         E = Class->method_end(); M != E; ++M) {
+      const CXXMethodDecl *MD = *M;
+      if (!MD->isVirtual())
+        continue;
+
+      if (const CXXDestructorDecl *DD = dyn_cast<CXXDestructorDecl>(MD)) {
+        Info.Components[AddressPoint +
+                        getMethodVTableIndex(GlobalDecl(DD, Dtor_Complete))] =
+          VTableComponent::MakeCompleteDtor(DD);
+        Info.Components[AddressPoint +
+                        getMethodVTableIndex(GlobalDecl(DD, Dtor_Deleting))] =
+          VTableComponent::MakeDeletingDtor(DD);
+      } else {
+        Info.Components[AddressPoint + getMethodVTableIndex(MD)] =
+          VTableComponent::MakeFunction(MD);
+      }
+    }
+
+    Info.AddressPoints.insert(std::make_pair(
+      BaseSubobject(Class, CharUnits::Zero()), AddressPoint));
+  }
+
+  // -fapple-kext adds an extra entry at end of vtbl.
+  if (Context.getLangOpts().AppleKext)
+    Info.Components.push_back(
+      VTableComponent::MakeVCallOffset(CharUnits::Zero()));
+
+  return true;
+}
+
+void VTableContext::computeVTableLayoutInfo(const CXXRecordDecl *RD,
+                                            VTableLayoutInfo &Info) {
+  // Only the vtable builder knows how to dump the layouts it computes.
+  if (!Context.getLangOpts().DumpVTableLayouts &&
+      ComputeSingleInheritanceVTableLayout(RD, Info))
     return;
 
   VTableBuilder Builder(*this, RD, CharUnits::Zero(), 
                         /*MostDerivedClassIsVirtual=*/0, RD);
-  Entry = CreateVTableLayout(Builder);
+  Info.Components.append(Builder.vtable_component_begin(),
+                         Builder.vtable_component_end());
+  Info.VTableThunks.append(Builder.vtable_thunks_begin(),
+                           Builder.vtable_thunks_end());
+  std::sort(Info.VTableThunks.begin(), Info.VTableThunks.end());
+  Info.AddressPoints = Builder.getAddressPoints();
+  Info.Thunks.append(Builder.thunks_begin(), Builder.thunks_end());
+  Info.VBaseOffsetOffsets.append(Builder.getVBaseOffsetOffsets().begin(),
+                                 Builder.getVBaseOffsetOffsets().end());
+}
+
+void VTableContext::ComputeVTableRelatedInformation(const CXXRecordDecl *RD) {
+  // Check if we've computed this information before.
+  if (VTableLayouts.count(RD))
+    return;
+
+  // A class loaded from an AST file may have its vtable layout stored there.
+  VTableLayoutInfo Info;
+  ExternalASTSource *External = Context.getExternalSource();
+  if (!RD->isFromASTFile() || !External ||
+      Context.getLangOpts().DumpVTableLayouts ||
+      !External->layoutVTable(RD, Info))
+    computeVTableLayoutInfo(RD, Info);
+
+  VTableLayouts[RD] = new VTableLayout(Info.Components.size(),
+                                       Info.Components.data(),
+                                       Info.VTableThunks.size(),
+                                       Info.VTableThunks.data(),
+                                       Info.AddressPoints,
+                                       isMicrosoftABI());
 
   // Add the known thunks.
-  Thunks.insert(Builder.thunks_begin(), Builder.thunks_end());
+  Thunks.insert(Info.Thunks.begin(), Info.Thunks.end());
 
-  // If we don't have the vbase information for this class, insert it.
-  // getVirtualBaseOffsetOffset will compute it separately without computing
-  // the rest of the vtable related information.
-  if (!RD->getNumVBases())
-    return;
-  
-  const RecordType *VBaseRT = 
-    RD->vbases_begin()->getType()->getAs<RecordType>();
-  const CXXRecordDecl *VBase = cast<CXXRecordDecl>(VBaseRT->getDecl());
-  
-  if (VirtualBaseClassOffsetOffsets.count(std::make_pair(RD, VBase)))
-    return;
-  
-  for (VTableBuilder::VBaseOffsetOffsetsMapTy::const_iterator I =
-       Builder.getVBaseOffsetOffsets().begin(), 
-       E = Builder.getVBaseOffsetOffsets().end(); I != E; ++I) {
-    // Insert all types.
-    ClassPairTy ClassPair(RD, I->first);
-    
-    VirtualBaseClassOffsetOffsets.insert(std::make_pair(ClassPair, I->second));
+  // Insert the vbase information for this class, unless
+  // getVirtualBaseOffsetOffset already computed it separately without
+  // computing the rest of the vtable related information.
+  for (unsigned I = 0, N = Info.VBaseOffsetOffsets.size(); I != N; ++I) {
+    ClassPairTy ClassPair(RD, Info.VBaseOffsetOffsets[I].first);
+    VirtualBaseClassOffsetOffsets.insert(
+        std::make_pair(ClassPair, Info.VBaseOffsetOffsets[I].second));
   }
 }
 
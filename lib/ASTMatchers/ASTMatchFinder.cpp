@@ -389,7 +389,19 @@ public:
                                  const DynTypedMatcher &Matcher,
                                  BoundNodesTreeBuilder *Builder,
                                  AncestorMatchMode MatchMode) {
-    return memoizedMatchesAncestorOfRecursively(Node, Matcher, Builder,
+    if (Node.get<TranslationUnitDecl>() ==
+        ActiveASTContext->getTranslationUnitDecl())
+      return false;
+    assert(Node.getMemoizationData() &&
+           "Invariant broken: only nodes that support memoization may be "
+           "used in the parent map.");
+    const ParentIndex &Index = ActiveASTContext->getParentIndex();
+    ParentIndex::NodeID ID = Index.getNodeID(Node);
+    if (ID == ParentIndex::InvalidNodeID) {
+      assert(false && "Found node that is not in the parent map.");
+      return false;
+    }
+    return memoizedMatchesAncestorOfRecursively(Index, ID, Matcher, Builder,
                                                 MatchMode);
   }
 
@@ -436,20 +448,19 @@ private:
   // Once there are multiple parents, the breadth first search order does not
   // allow simple memoization on the ancestors. Thus, we only memoize as long
   // as there is a single parent.
+  //
+  // The walk uses the IDs of the parent index, so that each step up the AST
+  // only indexes into the index instead of looking up the parents in a map.
   bool memoizedMatchesAncestorOfRecursively(
-      const ast_type_traits::DynTypedNode &Node, const DynTypedMatcher &Matcher,
-      BoundNodesTreeBuilder *Builder, AncestorMatchMode MatchMode) {
-    if (Node.get<TranslationUnitDecl>() ==
-        ActiveASTContext->getTranslationUnitDecl())
-      return false;
-    assert(Node.getMemoizationData() &&
-           "Invariant broken: only nodes that support memoization may be "
-           "used in the parent map.");
-    ASTContext::ParentVector Parents = ActiveASTContext->getParents(Node);
+      const ParentIndex &Index, ParentIndex::NodeID ID,
+      const DynTypedMatcher &Matcher, BoundNodesTreeBuilder *Builder,
+      AncestorMatchMode MatchMode) {
+    ArrayRef<ParentIndex::NodeID> Parents = Index.getParentIDs(ID);
     if (Parents.empty()) {
-      assert(false && "Found node that is not in the parent map.");
+      // Only the translation unit has no parents.
       return false;
     }
+    const ast_type_traits::DynTypedNode &Node = Index.getNode(ID);
     const UntypedMatchInput input(Matcher.getID(), Node.getMemoizationData());
     MemoizationMap::iterator I = ResultCache.find(input);
     if (I == ResultCache.end()) {
@@ -457,35 +468,33 @@ private:
       bool Matches = false;
       if (Parents.size() == 1) {
         // Only one parent - do recursive memoization.
-        const ast_type_traits::DynTypedNode Parent = Parents[0];
-        if (Matcher.matches(Parent, this, &AncestorBoundNodesBuilder)) {
+        if (Matcher.matches(Index.getNode(Parents[0]), this,
+                            &AncestorBoundNodesBuilder)) {
           Matches = true;
         } else if (MatchMode != ASTMatchFinder::AMM_ParentOnly) {
           Matches = memoizedMatchesAncestorOfRecursively(
-              Parent, Matcher, &AncestorBoundNodesBuilder, MatchMode);
+              Index, Parents[0], Matcher, &AncestorBoundNodesBuilder,
+              MatchMode);
         }
       } else {
         // Multiple parents - BFS over the rest of the nodes.
-        llvm::DenseSet<const void *> Visited;
-        std::deque<ast_type_traits::DynTypedNode> Queue(Parents.begin(),
-                                                        Parents.end());
+        llvm::DenseSet<ParentIndex::NodeID> Visited;
+        std::deque<ParentIndex::NodeID> Queue(Parents.begin(), Parents.end());
         while (!Queue.empty()) {
-          if (Matcher.matches(Queue.front(), this,
+          if (Matcher.matches(Index.getNode(Queue.front()), this,
                               &AncestorBoundNodesBuilder)) {
             Matches = true;
             break;
           }
           if (MatchMode != ASTMatchFinder::AMM_ParentOnly) {
-            ASTContext::ParentVector Ancestors =
-                ActiveASTContext->getParents(Queue.front());
-            for (ASTContext::ParentVector::const_iterator I = Ancestors.begin(),
-                                                          E = Ancestors.end();
-                 I != E; ++I) {
+            ArrayRef<ParentIndex::NodeID> Ancestors =
+                Index.getParentIDs(Queue.front());
+            for (unsigned I = 0, E = Ancestors.size(); I != E; ++I) {
               // Make sure we do not visit the same node twice.
               // Otherwise, we'll visit the common ancestors as often as there
               // are splits on the way down.
-              if (Visited.insert(I->getMemoizationData()).second)
-                Queue.push_back(*I);
+              if (Visited.insert(Ancestors[I]).second)
+                Queue.push_back(Ancestors[I]);
             }
           }
           Queue.pop_front();
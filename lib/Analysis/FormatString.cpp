@@ -802,3 +802,145 @@ bool FormatSpecifier::namedTypeToLengthModifier(QualType QT,
   }
   return false;
 }
+
+//===----------------------------------------------------------------------===//
+// Methods on RecordedFormatString.
+//===----------------------------------------------------------------------===//
+
+using clang::analyze_format_string::RecordedFormatString;
+
+void RecordedFormatString::parsePrintf(const char *beg, const char *end,
+                                       const LangOptions &LO,
+                                       const TargetInfo &Target) {
+  Beg = beg;
+  Stopped = ParsePrintfString(*this, beg, end, LO, Target);
+}
+
+void RecordedFormatString::parseScanf(const char *beg, const char *end,
+                                      const LangOptions &LO,
+                                      const TargetInfo &Target) {
+  Beg = beg;
+  Stopped = ParseScanfString(*this, beg, end, LO, Target);
+}
+
+bool RecordedFormatString::replay(FormatStringHandler &H) const {
+  for (std::vector<Event>::const_iterator I = Events.begin(),
+                                          E = Events.end();
+       I != E; ++I) {
+    switch (I->Kind) {
+    case EK_NullChar:
+      H.HandleNullChar(I->Start);
+      break;
+    case EK_Position:
+      H.HandlePosition(I->Start, I->Len);
+      break;
+    case EK_InvalidPosition:
+      H.HandleInvalidPosition(I->Start, I->Len, PositionContext(I->Data));
+      break;
+    case EK_ZeroPosition:
+      H.HandleZeroPosition(I->Start, I->Len);
+      break;
+    case EK_IncompleteSpecifier:
+      H.HandleIncompleteSpecifier(I->Start, I->Len);
+      break;
+    case EK_InvalidPrintfConversionSpecifier:
+      if (!H.HandleInvalidPrintfConversionSpecifier(PrintfSpecifiers[I->Data],
+                                                    I->Start, I->Len))
+        return true;
+      break;
+    case EK_PrintfSpecifier:
+      if (!H.HandlePrintfSpecifier(PrintfSpecifiers[I->Data], I->Start,
+                                   I->Len))
+        return true;
+      break;
+    case EK_InvalidScanfConversionSpecifier:
+      if (!H.HandleInvalidScanfConversionSpecifier(ScanfSpecifiers[I->Data],
+                                                   I->Start, I->Len))
+        return true;
+      break;
+    case EK_ScanfSpecifier:
+      if (!H.HandleScanfSpecifier(ScanfSpecifiers[I->Data], I->Start, I->Len))
+        return true;
+      break;
+    case EK_IncompleteScanList:
+      H.HandleIncompleteScanList(I->Start, I->End);
+      break;
+    }
+  }
+  return Stopped;
+}
+
+void RecordedFormatString::HandleNullChar(const char *nullCharacter) {
+  addEvent(EK_NullChar, nullCharacter, 0);
+}
+
+void RecordedFormatString::HandlePosition(const char *startPos,
+                                          unsigned posLen) {
+  addEvent(EK_Position, startPos, posLen);
+}
+
+void RecordedFormatString::HandleInvalidPosition(const char *startPos,
+                                                 unsigned posLen,
+                                                 PositionContext p) {
+  addEvent(EK_InvalidPosition, startPos, posLen, p);
+}
+
+void RecordedFormatString::HandleZeroPosition(const char *startPos,
+                                              unsigned posLen) {
+  addEvent(EK_ZeroPosition, startPos, posLen);
+}
+
+void RecordedFormatString::HandleIncompleteSpecifier(const char *startSpecifier,
+                                                     unsigned specifierLen) {
+  addEvent(EK_IncompleteSpecifier, startSpecifier, specifierLen);
+}
+
+bool RecordedFormatString::HandleInvalidPrintfConversionSpecifier(
+                                      const analyze_printf::PrintfSpecifier &FS,
+                                      const char *startSpecifier,
+                                      unsigned specifierLen) {
+  addEvent(EK_InvalidPrintfConversionSpecifier, startSpecifier, specifierLen,
+           PrintfSpecifiers.size());
+  PrintfSpecifiers.push_back(FS);
+  return true;
+}
+
+bool RecordedFormatString::HandlePrintfSpecifier(
+                                      const analyze_printf::PrintfSpecifier &FS,
+                                      const char *startSpecifier,
+                                      unsigned specifierLen) {
+  addEvent(EK_PrintfSpecifier, startSpecifier, specifierLen,
+           PrintfSpecifiers.size());
+  PrintfSpecifiers.push_back(FS);
+  return true;
+}
+
+bool RecordedFormatString::HandleInvalidScanfConversionSpecifier(
+                                        const analyze_scanf::ScanfSpecifier &FS,
+                                        const char *startSpecifier,
+                                        unsigned specifierLen) {
+  addEvent(EK_InvalidScanfConversionSpecifier, startSpecifier, specifierLen,
+           ScanfSpecifiers.size());
+  ScanfSpecifiers.push_back(FS);
+  return true;
+}
+
+bool RecordedFormatString::HandleScanfSpecifier(
+                                        const analyze_scanf::ScanfSpecifier &FS,
+                                        const char *startSpecifier,
+                                        unsigned specifierLen) {
+  addEvent(EK_ScanfSpecifier, startSpecifier, specifierLen,
+           ScanfSpecifiers.size());
+  ScanfSpecifiers.push_back(FS);
+  return true;
+}
+
+void RecordedFormatString::HandleIncompleteScanList(const char *start,
+                                                    const char *end) {
+  Event E;
+  E.Kind = EK_IncompleteScanList;
+  E.Start = start;
+  E.End = end;
+  E.Data = 0;
+  Events.push_back(E);
+}
@@ -42,6 +42,15 @@ static bool isTrackedVar(const VarDecl *vd, const DeclContext *dc) {
   return false;
 }
 
+bool clang::hasTrackedVariables(const DeclContext &dc) {
+  DeclContext::specific_decl_iterator<VarDecl> I(dc.decls_begin()),
+                                               E(dc.decls_end());
+  for ( ; I != E; ++I)
+    if (isTrackedVar(*I, &dc))
+      return true;
+  return false;
+}
+
 //------------------------------------------------------------------------====//
 // DeclToIndex: a mapping from Decls we track to value indices.
 //====------------------------------------------------------------------------//
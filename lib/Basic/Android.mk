@@ -29,6 +29,7 @@ clang_basic_SRC_FILES := \
   FileSystemStatCache.cpp \
   IdentifierTable.cpp \
   LangOptions.cpp \
+  MemoryReport.cpp \
   Module.cpp \
   ObjCRuntime.cpp \
   OperatorPrecedence.cpp \
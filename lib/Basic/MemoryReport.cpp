@@ -0,0 +1,83 @@
+//===--- MemoryReport.cpp - Memory usage breakdown ------------------------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file implements the MemoryReport class.
+//
+//===----------------------------------------------------------------------===//
+
+#include "clang/Basic/MemoryReport.h"
+#include "llvm/Support/Format.h"
+#include "llvm/Support/raw_ostream.h"
+#include <algorithm>
+using namespace clang;
+
+void MemoryReport::add(StringRef Category, StringRef Name, uint64_t Count,
+                       uint64_t Bytes) {
+  Entry E;
+  E.Category = Category;
+  E.Name = Name;
+  E.Count = Count;
+  E.Bytes = Bytes;
+  Entries.push_back(E);
+}
+
+uint64_t MemoryReport::getCategoryBytes(StringRef Category) const {
+  uint64_t Bytes = 0;
+  for (unsigned I = 0, N = Entries.size(); I != N; ++I)
+    if (Entries[I].Category == Category)
+      Bytes += Entries[I].Bytes;
+  return Bytes;
+}
+
+/// \brief Write the given string as a JSON string literal.
+static void writeJSONString(raw_ostream &OS, StringRef Str) {
+  OS << '"';
+  for (StringRef::iterator I = Str.begin(), E = Str.end(); I != E; ++I) {
+    unsigned char C = *I;
+    if (C == '"' || C == '\\')
+      OS << '\\' << C;
+    else if (C < 0x20)
+      OS << llvm::format("\\u%04x", C);
+    else
+      OS << C;
+  }
+  OS << '"';
+}
+
+void MemoryReport::writeJSON(raw_ostream &OS) const {
+  std::vector<StringRef> Categories;
+  for (unsigned I = 0, N = Entries.size(); I != N; ++I)
+    if (std::find(Categories.begin(), Categories.end(),
+                  StringRef(Entries[I].Category)) == Categories.end())
+      Categories.push_back(Entries[I].Category);
+
+  OS << "{\n\"categories\": [";
+  for (unsigned C = 0, NC = Categories.size(); C != NC; ++C) {
+    if (C)
+      OS << ',';
+    OS << "\n{\"name\": ";
+    writeJSONString(OS, Categories[C]);
+    OS << ", \"bytes\": " << getCategoryBytes(Categories[C])
+       << ", \"entries\": [";
+    bool First = true;
+    for (unsigned I = 0, N = Entries.size(); I != N; ++I) {
+      const Entry &E = Entries[I];
+      if (E.Category != Categories[C])
+        continue;
+      if (!First)
+        OS << ',';
+      First = false;
+      OS << "\n  {\"name\": ";
+      writeJSONString(OS, E.Name);
+      OS << ", \"count\": " << E.Count << ", \"bytes\": " << E.Bytes << "}";
+    }
+    OS << "]}";
+  }
+  OS << "\n]\n}\n";
+}
@@ -14,6 +14,7 @@
 #include "clang/Basic/SourceManager.h"
 #include "clang/Basic/Diagnostic.h"
 #include "clang/Basic/FileManager.h"
+#include "clang/Basic/MemoryReport.h"
 #include "clang/Basic/SourceManagerInternals.h"
 #include "llvm/ADT/Optional.h"
 #include "llvm/ADT/STLExtras.h"
@@ -2031,3 +2032,23 @@ size_t SourceManager::getDataStructureSizes() const {
 
   return size;
 }
+
+void SourceManager::reportMemoryUsage(MemoryReport &Report) const {
+  Report.add("SourceManager", "local SLocEntries", LocalSLocEntryTable.size(),
+             llvm::capacity_in_bytes(LocalSLocEntryTable));
+  Report.add("SourceManager", "loaded SLocEntries",
+             LoadedSLocEntryTable.size(),
+             llvm::capacity_in_bytes(LoadedSLocEntryTable) +
+             llvm::capacity_in_bytes(SLocEntryLoaded));
+  Report.add("SourceManager", "file infos", FileInfos.size(),
+             llvm::capacity_in_bytes(FileInfos) +
+             llvm::capacity_in_bytes(MemBufferInfos));
+  Report.add("SourceManager", "content caches",
+             FileInfos.size() + MemBufferInfos.size(), getContentCacheSize());
+
+  MemoryBufferSizes Buffers = getMemoryBufferSizes();
+  Report.add("SourceManager", "malloc'ed memory buffers", 0,
+             Buffers.malloc_bytes);
+  Report.add("SourceManager", "mmap'ed memory buffers", 0,
+             Buffers.mmap_bytes);
+}
@@ -36,6 +36,7 @@
 #include "clang/Basic/SourceManager.h"
 #include "clang/Basic/TargetInfo.h"
 #include "clang/Basic/TargetOptions.h"
+#include "clang/CodeGen/ModuleBuilder.h"
 #include "clang/Frontend/CodeGenOptions.h"
 #include "llvm/ADT/APSInt.h"
 #include "llvm/ADT/Triple.h"
@@ -77,7 +78,7 @@ CodeGenModule::CodeGenModule(ASTContext &C, const CodeGenOptions &CGO,
     TheModule(M), TheDataLayout(TD), TheTargetCodeGenInfo(0), Diags(diags),
     ABI(createCXXABI(*this)), 
     Types(*this),
-    TBAA(0),
+    TBAA(0), DeclFilter(0),
     VTables(*this), ObjCRuntime(0), OpenCLRuntime(0), CUDARuntime(0),
     DebugInfo(0), ARCData(0), NoObjCARCExceptionsMetadata(0),
     RRData(0), CFConstantStringClassRef(0),
@@ -2734,6 +2735,15 @@ void CodeGenModule::EmitTopLevelDecl(Decl *D) {
         cast<FunctionDecl>(D)->isLateTemplateParsed())
       return;
 
+    // Let the client skip definitions whose code it already has.
+    if (DeclFilter) {
+      const FunctionDecl *FD = cast<FunctionDecl>(D);
+      if (FD->doesThisDeclarationHaveABody() && !FD->isInlined() &&
+          FD->getLinkage() == ExternalLinkage &&
+          !DeclFilter->shouldEmitFunction(FD))
+        return;
+    }
+
     EmitGlobal(cast<FunctionDecl>(D));
     break;
       
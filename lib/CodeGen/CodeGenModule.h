@@ -57,6 +57,7 @@ namespace clang {
   class ObjCEncodeExpr;
   class BlockExpr;
   class CharUnits;
+  class CodeGenDeclFilter;
   class Decl;
   class Expr;
   class Stmt;
@@ -239,6 +240,9 @@ class CodeGenModule : public CodeGenTypeCache {
   CodeGenTypes Types;
   CodeGenTBAA *TBAA;
 
+  /// DeclFilter - Decides which function definitions are emitted, if set.
+  CodeGenDeclFilter *DeclFilter;
+
   /// VTables - Holds information about C++ vtables.
   CodeGenVTables VTables;
   friend class CodeGenVTables;
@@ -718,6 +722,10 @@ public:
   /// EmitTopLevelDecl - Emit code for a single top level declaration.
   void EmitTopLevelDecl(Decl *D);
 
+  /// setDeclFilter - Set the filter that decides which function definitions
+  /// EmitTopLevelDecl emits.
+  void setDeclFilter(CodeGenDeclFilter *Filter) { DeclFilter = Filter; }
+
   /// HandleCXXStaticMemberVarInstantiation - Tell the consumer that this
   // variable has been instantiated.
   void HandleCXXStaticMemberVarInstantiation(VarDecl *VD);
@@ -32,6 +32,7 @@ namespace {
     ASTContext *Ctx;
     const CodeGenOptions CodeGenOpts;  // Intentionally copied in.
     const TargetOptions TargetOpts;    // Intentionally copied in.
+    CodeGenDeclFilter *DeclFilter;
   protected:
     OwningPtr<llvm::Module> M;
     OwningPtr<CodeGen::CodeGenModule> Builder;
@@ -39,7 +40,7 @@ namespace {
     CodeGeneratorImpl(DiagnosticsEngine &diags, const std::string& ModuleName,
                       const CodeGenOptions &CGO, const TargetOptions &TO,
                       llvm::LLVMContext& C)
-      : Diags(diags), CodeGenOpts(CGO), TargetOpts(TO),
+      : Diags(diags), CodeGenOpts(CGO), TargetOpts(TO), DeclFilter(0),
         M(new llvm::Module(ModuleName, C)) {}
 
     virtual ~CodeGeneratorImpl() {}
@@ -52,6 +53,12 @@ namespace {
       return M.take();
     }
 
+    virtual void setDeclFilter(CodeGenDeclFilter *Filter) {
+      DeclFilter = Filter;
+      if (Builder)
+        Builder->setDeclFilter(Filter);
+    }
+
     virtual void Initialize(ASTContext &Context) {
       Ctx = &Context;
 
@@ -60,6 +67,7 @@ namespace {
       TD.reset(new llvm::DataLayout(Ctx->getTargetInfo().getTargetDescription()));
       Builder.reset(new CodeGen::CodeGenModule(Context, CodeGenOpts, TargetOpts,
                                                *M, *TD, Diags));
+      Builder->setDeclFilter(DeclFilter);
     }
 
     virtual void HandleCXXStaticMemberVarInstantiation(VarDecl *VD) {
@@ -122,6 +130,8 @@ namespace {
 
 void CodeGenerator::anchor() { }
 
+CodeGenDeclFilter::~CodeGenDeclFilter() { }
+
 CodeGenerator *clang::CreateLLVMCodeGen(DiagnosticsEngine &Diags,
                                         const std::string& ModuleName,
                                         const CodeGenOptions &CGO,
@@ -39,6 +39,9 @@ void ASTMergeAction::ExecuteAction() {
                                        &CI.getASTContext());
   IntrusiveRefCntPtr<DiagnosticIDs>
       DiagIDs(CI.getDiagnostics().getDiagnosticIDs());
+  // Tag definitions shared by several of the AST files are only compared
+  // against the merged AST once.
+  ASTImportIndex Index(CI.getASTContext());
   for (unsigned I = 0, N = ASTFiles.size(); I != N; ++I) {
     IntrusiveRefCntPtr<DiagnosticsEngine>
         Diags(new DiagnosticsEngine(DiagIDs, &CI.getDiagnosticOpts(),
@@ -54,6 +57,7 @@ void ASTMergeAction::ExecuteAction() {
                          Unit->getASTContext(), 
                          Unit->getFileManager(),
                          /*MinimalImport=*/false);
+    Importer.setSharedIndex(&Index);
 
     TranslationUnitDecl *TU = Unit->getASTContext().getTranslationUnitDecl();
     for (DeclContext::decl_iterator D = TU->decls_begin(), 
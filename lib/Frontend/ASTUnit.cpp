@@ -493,6 +493,7 @@ void ASTUnit::CacheCodeCompletionResults() {
 void ASTUnit::ClearCachedCompletionResults() {
   CachedCompletionResults.clear();
   CachedCompletionTypes.clear();
+  CachedMemberCompletionResults.clear();
   CachedCompletionAllocator = 0;
 }
 
@@ -1652,6 +1653,9 @@ llvm::MemoryBuffer *ASTUnit::getMainBufferWithPrecompiledPreamble(
   PreambleRebuildCounter = 1;
   PreprocessorOpts.eraseRemappedFile(
                                PreprocessorOpts.remapped_file_buffer_end() - 1);
+
+  // The members of classes in the preamble may have changed.
+  CachedMemberCompletionResults.clear();
   
   // If the hash of top-level entities differs from the hash of the top-level
   // entities the last time we rebuilt the preamble, clear out the completion
@@ -2112,12 +2116,20 @@ namespace {
     uint64_t NormalContexts;
     ASTUnit &AST;
     CodeCompleteConsumer &Next;
-    
+
+    /// \brief The cached member access results that semantic analysis was
+    /// told to use instead of looking for members, if any.
+    const std::vector<ASTUnit::CachedCodeCompletionResult> *CachedMemberResults;
+
+    void CacheMemberResults(Sema &S, StringRef Key,
+                            CodeCompletionResult *Results,
+                            unsigned NumResults);
+
   public:
     AugmentedCodeCompleteConsumer(ASTUnit &AST, CodeCompleteConsumer &Next,
                                   const CodeCompleteOptions &CodeCompleteOpts)
       : CodeCompleteConsumer(CodeCompleteOpts, Next.isOutputBinary()),
-        AST(AST), Next(Next)
+        AST(AST), Next(Next), CachedMemberResults(0)
     { 
       // Compute the set of contexts in which we will look when we don't have
       // any information about the specific context.
@@ -2142,6 +2154,9 @@ namespace {
                        |  (1LL << CodeCompletionContext::CCC_ClassOrStructTag);
     }
     
+    virtual bool hasCachedMemberResults(Sema &S,
+                                        const CodeCompletionContext &Context);
+
     virtual void ProcessCodeCompleteResults(Sema &S, 
                                             CodeCompletionContext Context,
                                             CodeCompletionResult *Results,
@@ -2248,10 +2263,150 @@ static void CalculateHiddenNames(const CodeCompletionContext &Context,
 }
 
 
+/// \brief Compute the key under which the results of a member access code
+/// completion in the given context are cached.
+///
+/// \returns false if the results cannot be cached, because the members of the
+/// base type or their accessibility may depend on the main file.
+static bool getMemberCompletionCacheKey(Sema &S,
+                                        const CodeCompletionContext &Context,
+                                        bool IncludeBriefComments,
+                                        SmallVectorImpl<char> &Key) {
+  if (Context.getKind() != CodeCompletionContext::CCC_DotMemberAccess &&
+      Context.getKind() != CodeCompletionContext::CCC_ArrowMemberAccess)
+    return false;
+
+  QualType BaseType = Context.getBaseType();
+  if (BaseType.isNull() || BaseType->isDependentType() ||
+      S.CurContext->isDependentContext())
+    return false;
+
+  // Only classes defined in the preamble have a fixed set of members.
+  const RecordType *Record = BaseType->getAs<RecordType>();
+  if (!Record)
+    return false;
+  RecordDecl *Def = Record->getDecl()->getDefinition();
+  if (!Def || !Def->isFromASTFile() || Def->isInAnonymousNamespace() ||
+      Def->getParentFunctionOrMethod())
+    return false;
+
+  llvm::raw_svector_ostream OS(Key);
+  OS << Context.getKind() << ':' << BaseType.getCVRQualifiers() << ':'
+     << IncludeBriefComments << ':'
+     << S.Context.getCanonicalType(BaseType).getUnqualifiedType().getAsString();
+
+  // Which members are accessible, and how they are named, depends on the
+  // context of the completion, so describe each enclosing function and
+  // class, along with the bases of the classes.
+  for (DeclContext *DC = S.CurContext; !DC->isTranslationUnit();
+       DC = DC->getParent()) {
+    if (FunctionDecl *FD = dyn_cast<FunctionDecl>(DC)) {
+      OS << '|' << FD->getQualifiedNameAsString() << ':'
+         << FD->getType().getAsString();
+    } else if (CXXRecordDecl *RD = dyn_cast<CXXRecordDecl>(DC)) {
+      if (!RD->hasDefinition())
+        return false;
+      OS << '|' << S.Context.getRecordType(RD).getAsString();
+      for (CXXRecordDecl::base_class_iterator B = RD->bases_begin(),
+                                           BEnd = RD->bases_end();
+           B != BEnd; ++B)
+        OS << ':' << B->getAccessSpecifier() << ' '
+           << S.Context.getCanonicalType(B->getType()).getAsString();
+    } else if (NamespaceDecl *NS = dyn_cast<NamespaceDecl>(DC)) {
+      if (NS->isAnonymousNamespace())
+        return false;
+      OS << '|' << NS->getQualifiedNameAsString();
+    } else if (!isa<BlockDecl>(DC) && !isa<LinkageSpecDecl>(DC)) {
+      return false;
+    }
+  }
+  OS.flush();
+  return true;
+}
+
+bool AugmentedCodeCompleteConsumer::hasCachedMemberResults(Sema &S,
+                                        const CodeCompletionContext &Context) {
+  CachedMemberResults = 0;
+  if (!AST.getCachedCompletionAllocator())
+    return false;
+
+  SmallString<128> Key;
+  if (!getMemberCompletionCacheKey(S, Context, includeBriefComments(), Key))
+    return false;
+
+  llvm::StringMap<std::vector<ASTUnit::CachedCodeCompletionResult> >::iterator
+    Pos = AST.getCachedMemberCompletionResults().find(Key);
+  if (Pos == AST.getCachedMemberCompletionResults().end())
+    return false;
+
+  CachedMemberResults = &Pos->second;
+  return true;
+}
+
+/// \brief Cache the results of a member access code completion on a class
+/// defined in the preamble.
+void AugmentedCodeCompleteConsumer::CacheMemberResults(Sema &S, StringRef Key,
+                                                 CodeCompletionResult *Results,
+                                                 unsigned NumResults) {
+  // Only cache results that refer to declarations in the preamble, or to
+  // the implicit members of classes in the preamble, which are declared on
+  // demand but do not depend on the main file.
+  for (unsigned I = 0; I != NumResults; ++I) {
+    if (Results[I].Kind != CodeCompletionResult::RK_Declaration)
+      return;
+    const NamedDecl *D = Results[I].Declaration;
+    if (!D->isFromASTFile() &&
+        !(D->isImplicit() && cast<Decl>(D->getDeclContext())->isFromASTFile()))
+      return;
+  }
+
+  GlobalCodeCompletionAllocator &Allocator = *AST.getCachedCompletionAllocator();
+  CodeCompletionTUInfo CCTUInfo(AST.getCachedCompletionAllocator());
+  std::vector<ASTUnit::CachedCodeCompletionResult> &Cached
+    = AST.getCachedMemberCompletionResults()[Key];
+  Cached.reserve(NumResults);
+  for (unsigned I = 0; I != NumResults; ++I) {
+    ASTUnit::CachedCodeCompletionResult CachedResult;
+    CachedResult.Completion
+      = Results[I].CreateCodeCompletionString(S, Allocator, CCTUInfo,
+                                              includeBriefComments());
+    CachedResult.ShowInContexts = 0;
+    CachedResult.Priority = Results[I].Priority;
+    CachedResult.Kind = Results[I].CursorKind;
+    CachedResult.Availability = Results[I].Availability;
+    CachedResult.TypeClass = STC_Void;
+    CachedResult.Type = 0;
+    Cached.push_back(CachedResult);
+  }
+}
+
 void AugmentedCodeCompleteConsumer::ProcessCodeCompleteResults(Sema &S,
                                             CodeCompletionContext Context,
                                             CodeCompletionResult *Results,
                                             unsigned NumResults) { 
+  typedef CodeCompletionResult Result;
+
+  // Member access completions are cached separately from global results.
+  if (CachedMemberResults) {
+    SmallVector<Result, 8> MemberResults;
+    MemberResults.reserve(CachedMemberResults->size());
+    for (unsigned I = 0, N = CachedMemberResults->size(); I != N; ++I) {
+      const ASTUnit::CachedCodeCompletionResult &C = (*CachedMemberResults)[I];
+      MemberResults.push_back(Result(C.Completion, C.Priority, C.Kind,
+                                     C.Availability));
+    }
+    CachedMemberResults = 0;
+    Next.ProcessCodeCompleteResults(S, Context, MemberResults.data(),
+                                    MemberResults.size());
+    return;
+  }
+
+  if (NumResults && AST.getCachedCompletionAllocator()) {
+    SmallString<128> Key;
+    if (getMemberCompletionCacheKey(S, Context, includeBriefComments(), Key))
+      CacheMemberResults(S, Key, Results, NumResults);
+  }
+
   // Merge the results we were given with the results we cached.
   bool AddedResult = false;
   uint64_t InContexts =
@@ -2259,7 +2414,6 @@ void AugmentedCodeCompleteConsumer::ProcessCodeCompleteResults(Sema &S,
         ? NormalContexts : (1LL << Context.getKind());
   // Contains the set of names that are hidden by "local" completion results.
   llvm::StringSet<llvm::BumpPtrAllocator> HiddenNames;
-  typedef CodeCompletionResult Result;
   SmallVector<Result, 8> AllResults;
   for (ASTUnit::cached_completion_iterator 
             C = AST.cached_completion_begin(),
@@ -13,6 +13,7 @@
 #include "clang/AST/Decl.h"
 #include "clang/Basic/Diagnostic.h"
 #include "clang/Basic/FileManager.h"
+#include "clang/Basic/MemoryReport.h"
 #include "clang/Basic/SourceManager.h"
 #include "clang/Basic/TargetInfo.h"
 #include "clang/Basic/Version.h"
@@ -416,6 +417,21 @@ void CompilerInstance::createSema(TranslationUnitKind TUKind,
                          TUKind, CompletionConsumer));
 }
 
+// Memory Usage
+
+void CompilerInstance::reportMemoryUsage(MemoryReport &Report) const {
+  if (hasSourceManager())
+    getSourceManager().reportMemoryUsage(Report);
+  if (hasPreprocessor())
+    getPreprocessor().reportMemoryUsage(Report);
+  if (hasASTContext())
+    getASTContext().reportMemoryUsage(Report);
+  if (hasSema())
+    getSema().reportMemoryUsage(Report);
+  if (ModuleManager)
+    ModuleManager->reportMemoryUsage(Report);
+}
+
 // Output Files
 
 void CompilerInstance::addOutputFile(const OutputFile &OutFile) {
@@ -11,6 +11,7 @@
 #include "clang/AST/ASTConsumer.h"
 #include "clang/AST/ASTContext.h"
 #include "clang/AST/DeclGroup.h"
+#include "clang/Basic/MemoryReport.h"
 #include "clang/Frontend/ASTUnit.h"
 #include "clang/Frontend/ChainedIncludesSource.h"
 #include "clang/Frontend/CompilerInstance.h"
@@ -21,6 +22,8 @@
 #include "clang/Lex/HeaderSearch.h"
 #include "clang/Lex/Preprocessor.h"
 #include "clang/Parse/ParseAST.h"
+#include "clang/Sema/Sema.h"
+#include "clang/Sema/TimeTrace.h"
 #include "clang/Serialization/ASTDeserializationListener.h"
 #include "clang/Serialization/ASTReader.h"
 #include "clang/Serialization/GlobalModuleIndex.h"
@@ -466,8 +469,36 @@ void ASTFrontendAction::ExecuteAction() {
   if (!CI.hasSema())
     CI.createSema(getTranslationUnitKind(), CompletionConsumer);
 
+  const std::string &TraceFile = CI.getFrontendOpts().TimeTraceFile;
+  if (!TraceFile.empty())
+    CI.getSema().TimeTracer.reset(new sema::TimeTrace());
+
   ParseAST(CI.getSema(), CI.getFrontendOpts().ShowStats,
            CI.getFrontendOpts().SkipFunctionBodies);
+
+  if (!TraceFile.empty()) {
+    std::string ErrorInfo;
+    llvm::raw_fd_ostream OS(TraceFile.c_str(), ErrorInfo);
+    if (ErrorInfo.empty())
+      CI.getSema().TimeTracer->writeJSON(OS);
+    else
+      CI.getDiagnostics().Report(diag::err_fe_unable_to_open_output)
+        << TraceFile << ErrorInfo;
+  }
+
+  const std::string &ReportFile = CI.getFrontendOpts().MemoryReportFile;
+  if (!ReportFile.empty()) {
+    MemoryReport Report;
+    CI.reportMemoryUsage(Report);
+
+    std::string ErrorInfo;
+    llvm::raw_fd_ostream OS(ReportFile.c_str(), ErrorInfo);
+    if (ErrorInfo.empty())
+      Report.writeJSON(OS);
+    else
+      CI.getDiagnostics().Report(diag::err_fe_unable_to_open_output)
+        << ReportFile << ErrorInfo;
+  }
 }
 
 void PluginASTAction::anchor() { }
@@ -28,6 +28,7 @@
 #include "clang/Lex/Preprocessor.h"
 #include "MacroArgs.h"
 #include "clang/Basic/FileManager.h"
+#include "clang/Basic/MemoryReport.h"
 #include "clang/Basic/SourceManager.h"
 #include "clang/Basic/TargetInfo.h"
 #include "clang/Lex/CodeCompletionHandler.h"
@@ -281,6 +282,47 @@ size_t Preprocessor::getTotalMemory() const {
     + llvm::capacity_in_bytes(CommentHandlers);
 }
 
+void Preprocessor::reportMemoryUsage(MemoryReport &Report) const {
+  Report.add("Preprocessor", "allocator", 0, BP.getTotalMemory());
+  Report.add("Preprocessor", "macro expanded tokens",
+             MacroExpandedTokens.size(),
+             llvm::capacity_in_bytes(MacroExpandedTokens));
+  Report.add("Preprocessor", "side tables", 0,
+             Predefines.capacity() +
+             llvm::capacity_in_bytes(PragmaPushMacroInfo) +
+             llvm::capacity_in_bytes(PoisonReasons) +
+             llvm::capacity_in_bytes(CommentHandlers));
+  Report.add("Preprocessor", "header search", 0, HeaderInfo.getTotalMemory());
+  if (Record)
+    Report.add("Preprocessor", "preprocessing record", 0,
+               Record->getTotalMemory());
+
+  // Macro definitions live in the preprocessor's allocator; count them
+  // separately so that large macro-heavy headers stand out.
+  unsigned NumDefinitions = 0;
+  uint64_t DefinitionBytes = 0;
+  for (macro_iterator I = Macros.begin(), E = Macros.end(); I != E; ++I) {
+    for (const MacroDirective *MD = I->second; MD; MD = MD->getPrevious()) {
+      ++NumDefinitions;
+      DefinitionBytes += sizeof(MacroDirective);
+      const MacroInfo *MI = MD->getInfo();
+      if (!MI)
+        continue;
+      DefinitionBytes += sizeof(MacroInfo) +
+                         MI->getNumArgs() * sizeof(IdentifierInfo *);
+      // The first eight tokens are stored in the MacroInfo itself.
+      if (MI->getNumTokens() > 8)
+        DefinitionBytes += MI->getNumTokens() * sizeof(Token);
+    }
+  }
+  Report.add("Macros", "macro table", Macros.size(),
+             llvm::capacity_in_bytes(Macros));
+  Report.add("Macros", "macro definitions", NumDefinitions, DefinitionBytes);
+
+  Report.add("Identifiers", "identifiers", Identifiers.size(),
+             Identifiers.getAllocator().getTotalMemory());
+}
+
 Preprocessor::macro_iterator
 Preprocessor::macro_end(bool IncludeExternalMacros) const {
   if (IncludeExternalMacros && ExternalSource &&
@@ -1425,7 +1425,9 @@ clang::sema::AnalysisBasedWarnings::AnalysisBasedWarnings(Sema &s)
     NumUninitAnalysisVariables(0),
     MaxUninitAnalysisVariablesPerFunction(0),
     NumUninitAnalysisBlockVisits(0),
-    MaxUninitAnalysisBlockVisitsPerFunction(0) {
+    MaxUninitAnalysisBlockVisitsPerFunction(0),
+    NumUninitAnalysisSkipped(0),
+    NumThreadSafetyAnalysisSkipped(0) {
   DiagnosticsEngine &D = S.getDiagnostics();
   DefaultPolicy.enableCheckUnreachable = (unsigned)
     (D.getDiagnosticLevel(diag::warn_unreachable, SourceLocation()) !=
@@ -1478,6 +1480,29 @@ AnalysisBasedWarnings::IssueWarnings(sema::AnalysisBasedWarnings::Policy P,
   const Stmt *Body = D->getBody();
   assert(Body);
 
+  // Decide up front which of the CFG-based analyses can have anything to
+  // say about this function, using checks that do not need the CFG, so that
+  // the CFG is only built (and linearized) when some analysis needs it.
+  bool EnableThreadSafetyAnalysis = P.enableThreadSafetyAnalysis;
+  if (EnableThreadSafetyAnalysis && !S.SeenThreadSafetyAttributes &&
+      !S.getExternalSource()) {
+    // The analysis only reports on uses of its attributes.
+    EnableThreadSafetyAnalysis = false;
+    ++NumThreadSafetyAnalysisSkipped;
+  }
+
+  bool EnableUninitAnalysis =
+      Diags.getDiagnosticLevel(diag::warn_uninit_var, D->getLocStart())
+      != DiagnosticsEngine::Ignored ||
+      Diags.getDiagnosticLevel(diag::warn_sometimes_uninit_var,D->getLocStart())
+      != DiagnosticsEngine::Ignored ||
+      Diags.getDiagnosticLevel(diag::warn_maybe_uninit_var, D->getLocStart())
+      != DiagnosticsEngine::Ignored;
+  if (EnableUninitAnalysis && !hasTrackedVariables(*cast<DeclContext>(D))) {
+    EnableUninitAnalysis = false;
+    ++NumUninitAnalysisSkipped;
+  }
+
   AnalysisDeclContext AC(/* AnalysisDeclContextManager */ 0, D);
 
   // Don't generate EH edges for CallExprs as we'd like to avoid the n^2
@@ -1494,7 +1519,7 @@ AnalysisBasedWarnings::IssueWarnings(sema::AnalysisBasedWarnings::Policy P,
   // prototyping, but we need a way for analyses to say what expressions they
   // expect to always be CFGElements and then fill in the BuildOptions
   // appropriately.  This is essentially a layering violation.
-  if (P.enableCheckUnreachable || P.enableThreadSafetyAnalysis) {
+  if (P.enableCheckUnreachable || EnableThreadSafetyAnalysis) {
     // Unreachable code analysis and thread safety require a linearized CFG.
     AC.getCFGBuildOptions().setAllAlwaysAdd();
   }
@@ -1586,7 +1611,7 @@ AnalysisBasedWarnings::IssueWarnings(sema::AnalysisBasedWarnings::Policy P,
   }
 
   // Check for thread safety violations
-  if (P.enableThreadSafetyAnalysis) {
+  if (EnableThreadSafetyAnalysis) {
     SourceLocation FL = AC.getDecl()->getLocation();
     SourceLocation FEL = AC.getDecl()->getLocEnd();
     thread_safety::ThreadSafetyReporter Reporter(S, FL, FEL);
@@ -1598,12 +1623,7 @@ AnalysisBasedWarnings::IssueWarnings(sema::AnalysisBasedWarnings::Policy P,
     Reporter.emitDiagnostics();
   }
 
-  if (Diags.getDiagnosticLevel(diag::warn_uninit_var, D->getLocStart())
-      != DiagnosticsEngine::Ignored ||
-      Diags.getDiagnosticLevel(diag::warn_sometimes_uninit_var,D->getLocStart())
-      != DiagnosticsEngine::Ignored ||
-      Diags.getDiagnosticLevel(diag::warn_maybe_uninit_var, D->getLocStart())
-      != DiagnosticsEngine::Ignored) {
+  if (EnableUninitAnalysis) {
     if (CFG *cfg = AC.getCFG()) {
       UninitValsDiagReporter reporter(S);
       UninitVariablesAnalysisStats stats;
@@ -1685,4 +1705,11 @@ void clang::sema::AnalysisBasedWarnings::PrintStats() const {
                << " average block visits per function.\n"
                << "  " << MaxUninitAnalysisBlockVisitsPerFunction
                << " max block visits per function.\n";
+
+  llvm::errs() << NumUninitAnalysisSkipped
+               << " functions skipped uninitialized variables analysis"
+               << " (no tracked variables).\n"
+               << NumThreadSafetyAnalysisSkipped
+               << " functions skipped thread safety analysis"
+               << " (no thread safety attributes).\n";
 }
@@ -67,7 +67,8 @@ clang_sema_SRC_FILES :=	\
 	SemaTemplateInstantiateDecl.cpp	\
 	SemaTemplateVariadic.cpp	\
 	SemaType.cpp	\
-	TargetAttributesSema.cpp
+	TargetAttributesSema.cpp	\
+	TimeTrace.cpp
 
 LOCAL_SRC_FILES := $(clang_sema_SRC_FILES)
 
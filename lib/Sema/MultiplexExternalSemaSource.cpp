@@ -161,6 +161,14 @@ bool MultiplexExternalSemaSource::layoutRecordType(const RecordDecl *Record,
   return false;
 }
 
+bool MultiplexExternalSemaSource::layoutVTable(const CXXRecordDecl *RD,
+                                               VTableLayoutInfo &Info) {
+  for(size_t i = 0; i < Sources.size(); ++i)
+    if (Sources[i]->layoutVTable(RD, Info))
+      return true;
+  return false;
+}
+
 void MultiplexExternalSemaSource::
 getMemoryBufferSizes(MemoryBufferSizes &sizes) const {
   for(size_t i = 0; i < Sources.size(); ++i)
@@ -22,7 +22,9 @@
 #include "clang/AST/Expr.h"
 #include "clang/AST/ExprCXX.h"
 #include "clang/AST/StmtCXX.h"
+#include "clang/Analysis/Analyses/FormatString.h"
 #include "clang/Basic/FileManager.h"
+#include "clang/Basic/MemoryReport.h"
 #include "clang/Basic/PartialDiagnostic.h"
 #include "clang/Basic/TargetInfo.h"
 #include "clang/Lex/HeaderSearch.h"
@@ -37,9 +39,11 @@
 #include "clang/Sema/ScopeInfo.h"
 #include "clang/Sema/SemaConsumer.h"
 #include "clang/Sema/TemplateDeduction.h"
+#include "clang/Sema/TimeTrace.h"
 #include "llvm/ADT/APFloat.h"
 #include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/SmallSet.h"
+#include "llvm/Support/Capacity.h"
 #include "llvm/Support/CrashRecoveryContext.h"
 using namespace clang;
 using namespace sema;
@@ -84,7 +88,7 @@ Sema::Sema(Preprocessor &pp, ASTContext &ctxt, ASTConsumer &consumer,
     NSStringDecl(0), StringWithUTF8StringMethod(0),
     NSArrayDecl(0), ArrayWithObjectsMethod(0),
     NSDictionaryDecl(0), DictionaryWithObjectsMethod(0),
-    GlobalNewDeleteDeclared(false),
+    GlobalNewDeleteDeclared(false), SeenThreadSafetyAttributes(false),
     TUKind(TUKind),
     NumSFINAEErrors(0), InFunctionDeclarator(0),
     AccessCheckingSFINAE(false), InNonInstantiationSFINAEContext(false),
@@ -93,8 +97,12 @@ Sema::Sema(Preprocessor &pp, ASTContext &ctxt, ASTConsumer &consumer,
     AnalysisWarnings(*this), Ident_super(0)
 {
   TUScope = 0;
+  NumFormatStringChecks = 0;
+  NumFormatStringReuses = 0;
+  CanThrowResultIsProvisional = false;
 
   LoadedExternalKnownNamespaces = false;
+  LoadedExternalTypoCandidates = false;
   for (unsigned I = 0; I != NSAPI::NumNSNumberLiteralMethods; ++I)
     NSNumberLiteralMethods[I] = 0;
 
@@ -183,6 +191,11 @@ Sema::~Sema() {
   if (FunctionScopes.size() == 1)
     delete FunctionScopes[0];
 
+  for (llvm::StringMap<analyze_format_string::RecordedFormatString *>::iterator
+         I = ParsedFormatStrings.begin(), E = ParsedFormatStrings.end();
+       I != E; ++I)
+    delete I->second;
+
   // Tell the SemaConsumer to forget about us; we're going out of scope.
   if (SemaConsumer *SC = dyn_cast<SemaConsumer>(&Consumer))
     SC->ForgetSema();
@@ -251,11 +264,22 @@ void Sema::addExternalSource(ExternalSemaSource *E) {
 void Sema::PrintStats() const {
   llvm::errs() << "\n*** Semantic Analysis Stats:\n";
   llvm::errs() << NumSFINAEErrors << " SFINAE diagnostics trapped.\n";
+  llvm::errs() << NumFormatStringChecks << " format strings checked, "
+               << NumFormatStringReuses << " reused an earlier parse.\n";
 
   BumpAlloc.PrintStats();
   AnalysisWarnings.PrintStats();
 }
 
+void Sema::reportMemoryUsage(MemoryReport &Report) const {
+  Report.add("Sema", "allocator", 0, BumpAlloc.getTotalMemory());
+  Report.add("Sema", "global method pool", MethodPool.size(),
+             llvm::capacity_in_bytes(MethodPool));
+  Report.add("Sema", "pending instantiations", PendingInstantiations.size(),
+             PendingInstantiations.size() *
+             sizeof(PendingImplicitInstantiation));
+}
+
 /// ImpCastExprToType - If Expr is not of type 'Type', insert an implicit cast.
 /// If there is already an implicit cast, merge into the existing one.
 /// The result is of the given category.
@@ -587,6 +611,11 @@ void Sema::ActOnEndOfTranslationUnit() {
     // future, we either need to be able to filter the results of name lookup
     // or we need to perform template instantiations earlier.
     PerformPendingInstantiations();
+  } else if (TUKind == TU_Prefix && LangOpts.PCHInstantiateTemplates) {
+    // Perform the implicit instantiations required by the precompiled header
+    // now, so that their definitions are written into the AST file and
+    // reused by every translation unit that includes it.
+    PerformPendingInstantiations();
   }
 
   // Remove file scoped decls that turned out to be used.
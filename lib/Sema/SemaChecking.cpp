@@ -3135,26 +3135,50 @@ void Sema::CheckFormatString(const StringLiteral *FExpr,
     return;
   }
   
-  if (Type == FST_Printf || Type == FST_NSString) {
+  if (Type != FST_Printf && Type != FST_NSString && Type != FST_Scanf)
+    return; // TODO: handle other formats
+  bool IsScanf = Type == FST_Scanf;
+
+  // The same literal is often used by many calls, e.g. through a logging
+  // macro, so only parse it once and replay the result to the handler for
+  // each call.
+  ++NumFormatStringChecks;
+  SmallString<64> Key;
+  Key += IsScanf ? 's' : 'p';
+  Key += StrRef;
+  analyze_format_string::RecordedFormatString *&Parsed
+    = ParsedFormatStrings[Key];
+  if (Parsed) {
+    ++NumFormatStringReuses;
+  } else {
+    Parsed = new analyze_format_string::RecordedFormatString;
+    if (IsScanf)
+      Parsed->parseScanf(Str, Str + StrLen, getLangOpts(),
+                         Context.getTargetInfo());
+    else
+      Parsed->parsePrintf(Str, Str + StrLen, getLangOpts(),
+                          Context.getTargetInfo());
+  }
+
+  // The recorded positions point into the literal that was parsed first.
+  Str = Parsed->getBegin();
+
+  if (!IsScanf) {
     CheckPrintfHandler H(*this, FExpr, OrigFormatExpr, firstDataArg,
                          numDataArgs, (Type == FST_NSString),
                          Str, HasVAListArg, Args, format_idx,
                          inFunctionCall, CallType);
   
-    if (!analyze_format_string::ParsePrintfString(H, Str, Str + StrLen,
-                                                  getLangOpts(),
-                                                  Context.getTargetInfo()))
+    if (!Parsed->replay(H))
       H.DoneProcessing();
-  } else if (Type == FST_Scanf) {
+  } else {
     CheckScanfHandler H(*this, FExpr, OrigFormatExpr, firstDataArg, numDataArgs,
                         Str, HasVAListArg, Args, format_idx,
                         inFunctionCall, CallType);
     
-    if (!analyze_format_string::ParseScanfString(H, Str, Str + StrLen,
-                                                 getLangOpts(),
-                                                 Context.getTargetInfo()))
+    if (!Parsed->replay(H))
       H.DoneProcessing();
-  } // TODO: handle other formats
+  }
 }
 
 //===--- CHECK: Standard memory functions ---------------------------------===//
@@ -3566,6 +3566,17 @@ void Sema::CodeCompleteMemberReferenceExpr(Scope *S, Expr *Base,
     }
   }
   
+  // The consumer may have cached the members of this record type from a
+  // previous completion.
+  if (BaseType->getAs<RecordType>() &&
+      CodeCompleter->hasCachedMemberResults(*this,
+                                CodeCompletionContext(contextKind, BaseType))) {
+    HandleCodeCompleteResults(this, CodeCompleter,
+                              CodeCompletionContext(contextKind, BaseType),
+                              0, 0);
+    return;
+  }
+
   ResultBuilder Results(*this, CodeCompleter->getAllocator(),
                         CodeCompleter->getCodeCompletionTUInfo(),
                   CodeCompletionContext(contextKind,
@@ -4688,8 +4688,39 @@ static void ProcessNonInheritableDeclAttr(Sema &S, Scope *scope, Decl *D,
   }
 }
 
+/// \brief Determine whether the given attribute is one that the thread safety
+/// analysis reads.
+static bool isThreadSafetyAttr(AttributeList::Kind Kind) {
+  switch (Kind) {
+  case AttributeList::AT_GuardedVar:
+  case AttributeList::AT_PtGuardedVar:
+  case AttributeList::AT_ScopedLockable:
+  case AttributeList::AT_Lockable:
+  case AttributeList::AT_GuardedBy:
+  case AttributeList::AT_PtGuardedBy:
+  case AttributeList::AT_ExclusiveLockFunction:
+  case AttributeList::AT_ExclusiveLocksRequired:
+  case AttributeList::AT_ExclusiveTrylockFunction:
+  case AttributeList::AT_LockReturned:
+  case AttributeList::AT_LocksExcluded:
+  case AttributeList::AT_SharedLockFunction:
+  case AttributeList::AT_SharedLocksRequired:
+  case AttributeList::AT_SharedTrylockFunction:
+  case AttributeList::AT_UnlockFunction:
+  case AttributeList::AT_AcquiredBefore:
+  case AttributeList::AT_AcquiredAfter:
+    return true;
+  default:
+    return false;
+  }
+}
+
 static void ProcessInheritableDeclAttr(Sema &S, Scope *scope, Decl *D,
                                        const AttributeList &Attr) {
+  // Thread safety analysis is skipped until it has something to check.
+  if (isThreadSafetyAttr(Attr.getKind()))
+    S.SeenThreadSafetyAttributes = true;
+
   switch (Attr.getKind()) {
   case AttributeList::AT_IBAction:    handleIBAction(S, D, Attr); break;
   case AttributeList::AT_IBOutlet:    handleIBOutlet(S, D, Attr); break;
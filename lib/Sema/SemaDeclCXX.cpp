@@ -1406,17 +1406,26 @@ Sema::CheckDerivedToBaseConversion(QualType Derived, QualType Base,
                                    DeclarationName Name,
                                    CXXCastPath *BasePath) {
   // First, determine whether the path from Derived to Base is
-  // ambiguous. This is slightly more expensive than checking whether
-  // the Derived to Base conversion exists, because here we need to
-  // explore multiple paths to determine if there is an ambiguity.
-  CXXBasePaths Paths(/*FindAmbiguities=*/true, /*RecordPaths=*/true,
+  // ambiguous. The set of base classes of Derived tells us without
+  // exploring the paths; otherwise, we need to explore multiple paths to
+  // determine if there is an ambiguity, which is slightly more expensive
+  // than checking whether the Derived to Base conversion exists.
+  const CXXBaseSet *Bases = 0;
+  CXXRecordDecl *DerivedRD = GetClassForType(Derived);
+  CXXRecordDecl *BaseRD = GetClassForType(Base);
+  if (DerivedRD && BaseRD)
+    Bases = Context.getCXXBaseSet(DerivedRD);
+
+  CXXBasePaths Paths(/*FindAmbiguities=*/!Bases, /*RecordPaths=*/true,
                      /*DetectVirtual=*/false);
   bool DerivationOkay = IsDerivedFrom(Derived, Base, Paths);
   assert(DerivationOkay &&
          "Can only be used with a derived-to-base conversion");
   (void)DerivationOkay;
   
-  if (!Paths.isAmbiguous(Context.getCanonicalType(Base).getUnqualifiedType())) {
+  bool Ambiguous = Bases ? Bases->isAmbiguous(BaseRD)
+    : Paths.isAmbiguous(Context.getCanonicalType(Base).getUnqualifiedType());
+  if (!Ambiguous) {
     if (InaccessibleBaseID) {
       // Check that the base class can be accessed.
       switch (CheckBaseClassAccess(Loc, Base, Derived, Paths.front(),
@@ -1443,6 +1452,7 @@ Sema::CheckDerivedToBaseConversion(QualType Derived, QualType Base,
   // the previous derived-to-base checks we've done, but at this point
   // performance isn't as much of an issue.
   Paths.clear();
+  Paths.setFindAmbiguities(true);
   Paths.setRecordingPaths(true);
   bool StillOkay = IsDerivedFrom(Derived, Base, Paths);
   assert(StillOkay && "Can only be used with a derived-to-base conversion");
@@ -7417,6 +7427,29 @@ Decl *Sema::ActOnNamespaceAliasDef(Scope *S,
   return AliasDecl;
 }
 
+/// \brief Determine whether the implicit default constructor or destructor
+/// of \p RD is trivial, and so cannot throw.
+///
+/// The triviality of a class's special members is computed incrementally as
+/// its members and bases are added, so this lets the exception specification
+/// of a derived class's special member be computed without looking up the
+/// corresponding base or member special member, declaring it, or evaluating
+/// its exception specification. In deep hierarchies of trivial classes, this
+/// avoids repeating that work for every class in the hierarchy.
+static bool hasTrivialNonThrowingSpecialMember(CXXRecordDecl *RD,
+                                               Sema::CXXSpecialMember CSM) {
+  if (RD->isInvalidDecl() || !RD->hasDefinition())
+    return false;
+  switch (CSM) {
+  case Sema::CXXDefaultConstructor:
+    return RD->hasTrivialDefaultConstructor();
+  case Sema::CXXDestructor:
+    return RD->hasTrivialDestructor();
+  default:
+    return false;
+  }
+}
+
 Sema::ImplicitExceptionSpecification
 Sema::ComputeDefaultedDefaultCtorExceptionSpec(SourceLocation Loc,
                                                CXXMethodDecl *MD) {
@@ -7438,6 +7471,9 @@ Sema::ComputeDefaultedDefaultCtorExceptionSpec(SourceLocation Loc,
     
     if (const RecordType *BaseType = B->getType()->getAs<RecordType>()) {
       CXXRecordDecl *BaseClassDecl = cast<CXXRecordDecl>(BaseType->getDecl());
+      if (hasTrivialNonThrowingSpecialMember(BaseClassDecl,
+                                             CXXDefaultConstructor))
+        continue;
       CXXConstructorDecl *Constructor = LookupDefaultConstructor(BaseClassDecl);
       // If this is a deleted function, add it anyway. This might be conformant
       // with the standard. This might not. I'm not sure. It might not matter.
@@ -7452,6 +7488,9 @@ Sema::ComputeDefaultedDefaultCtorExceptionSpec(SourceLocation Loc,
        B != BEnd; ++B) {
     if (const RecordType *BaseType = B->getType()->getAs<RecordType>()) {
       CXXRecordDecl *BaseClassDecl = cast<CXXRecordDecl>(BaseType->getDecl());
+      if (hasTrivialNonThrowingSpecialMember(BaseClassDecl,
+                                             CXXDefaultConstructor))
+        continue;
       CXXConstructorDecl *Constructor = LookupDefaultConstructor(BaseClassDecl);
       // If this is a deleted function, add it anyway. This might be conformant
       // with the standard. This might not. I'm not sure. It might not matter.
@@ -7486,6 +7525,9 @@ Sema::ComputeDefaultedDefaultCtorExceptionSpec(SourceLocation Loc,
     } else if (const RecordType *RecordTy
               = Context.getBaseElementType(F->getType())->getAs<RecordType>()) {
       CXXRecordDecl *FieldRecDecl = cast<CXXRecordDecl>(RecordTy->getDecl());
+      if (hasTrivialNonThrowingSpecialMember(FieldRecDecl,
+                                             CXXDefaultConstructor))
+        continue;
       CXXConstructorDecl *Constructor = LookupDefaultConstructor(FieldRecDecl);
       // If this is a deleted function, add it anyway. This might be conformant
       // with the standard. This might not. I'm not sure. It might not matter.
@@ -7884,18 +7926,24 @@ Sema::ComputeDefaultedDtorExceptionSpec(CXXMethodDecl *MD) {
     if (B->isVirtual()) // Handled below.
       continue;
     
-    if (const RecordType *BaseType = B->getType()->getAs<RecordType>())
-      ExceptSpec.CalledDecl(B->getLocStart(),
-                   LookupDestructor(cast<CXXRecordDecl>(BaseType->getDecl())));
+    if (const RecordType *BaseType = B->getType()->getAs<RecordType>()) {
+      CXXRecordDecl *BaseClassDecl = cast<CXXRecordDecl>(BaseType->getDecl());
+      if (!hasTrivialNonThrowingSpecialMember(BaseClassDecl, CXXDestructor))
+        ExceptSpec.CalledDecl(B->getLocStart(),
+                              LookupDestructor(BaseClassDecl));
+    }
   }
 
   // Virtual base-class destructors.
   for (CXXRecordDecl::base_class_iterator B = ClassDecl->vbases_begin(),
                                        BEnd = ClassDecl->vbases_end();
        B != BEnd; ++B) {
-    if (const RecordType *BaseType = B->getType()->getAs<RecordType>())
-      ExceptSpec.CalledDecl(B->getLocStart(),
-                  LookupDestructor(cast<CXXRecordDecl>(BaseType->getDecl())));
+    if (const RecordType *BaseType = B->getType()->getAs<RecordType>()) {
+      CXXRecordDecl *BaseClassDecl = cast<CXXRecordDecl>(BaseType->getDecl());
+      if (!hasTrivialNonThrowingSpecialMember(BaseClassDecl, CXXDestructor))
+        ExceptSpec.CalledDecl(B->getLocStart(),
+                              LookupDestructor(BaseClassDecl));
+    }
   }
 
   // Field destructors.
@@ -7903,9 +7951,12 @@ Sema::ComputeDefaultedDtorExceptionSpec(CXXMethodDecl *MD) {
                                FEnd = ClassDecl->field_end();
        F != FEnd; ++F) {
     if (const RecordType *RecordTy
-        = Context.getBaseElementType(F->getType())->getAs<RecordType>())
-      ExceptSpec.CalledDecl(F->getLocation(),
-                  LookupDestructor(cast<CXXRecordDecl>(RecordTy->getDecl())));
+        = Context.getBaseElementType(F->getType())->getAs<RecordType>()) {
+      CXXRecordDecl *FieldRecDecl = cast<CXXRecordDecl>(RecordTy->getDecl());
+      if (!hasTrivialNonThrowingSpecialMember(FieldRecDecl, CXXDestructor))
+        ExceptSpec.CalledDecl(F->getLocation(),
+                              LookupDestructor(FieldRecDecl));
+    }
   }
 
   return ExceptSpec;
@@ -854,7 +854,25 @@ static CanThrowResult canCalleeThrow(Sema &S, const Expr *E,
   if (!FT)
     return CT_Can;
 
-  return FT->isNothrow(S.Context) ? CT_Cannot : CT_Can;
+  // The members of a class that is still being defined can have their types
+  // replaced when it is complete; notably, a destructor declared without an
+  // exception specification only becomes noexcept then. Expressions calling
+  // them must be checked again later.
+  if (const CXXMethodDecl *MD = dyn_cast<CXXMethodDecl>(D))
+    if (MD->getParent()->isBeingDefined())
+      S.CanThrowResultIsProvisional = true;
+
+  // Evaluating a noexcept-specification can be expensive, and the same
+  // function type tends to be called many times. A resolved function type
+  // always has the same exception specification.
+  llvm::DenseMap<const FunctionProtoType *, CanThrowResult>::iterator Known
+    = S.CalleeCanThrowCache.find(FT);
+  if (Known != S.CalleeCanThrowCache.end())
+    return Known->second;
+
+  CanThrowResult CT = FT->isNothrow(S.Context) ? CT_Cannot : CT_Can;
+  S.CalleeCanThrowCache[FT] = CT;
+  return CT;
 }
 
 static CanThrowResult canDynamicCastThrow(const CXXDynamicCastExpr *DC) {
@@ -891,7 +909,7 @@ static CanThrowResult canTypeidThrow(Sema &S, const CXXTypeidExpr *DC) {
   return CT_Can;
 }
 
-CanThrowResult Sema::canThrow(const Expr *E) {
+static CanThrowResult computeCanThrow(Sema &S, const Expr *E) {
   // C++ [expr.unary.noexcept]p3:
   //   [Can throw] if in a potentially-evaluated context the expression would
   //   contain:
@@ -906,13 +924,13 @@ CanThrowResult Sema::canThrow(const Expr *E) {
     CanThrowResult CT = canDynamicCastThrow(cast<CXXDynamicCastExpr>(E));
     if (CT == CT_Can)
       return CT;
-    return mergeCanThrow(CT, canSubExprsThrow(*this, E));
+    return mergeCanThrow(CT, canSubExprsThrow(S, E));
   }
 
   case Expr::CXXTypeidExprClass:
     //   - a potentially evaluated typeid expression applied to a glvalue
     //     expression whose type is a polymorphic class type
-    return canTypeidThrow(*this, cast<CXXTypeidExpr>(E));
+    return canTypeidThrow(S, cast<CXXTypeidExpr>(E));
 
     //   - a potentially evaluated call to a function, member function, function
     //     pointer, or member function pointer that does not have a non-throwing
@@ -928,19 +946,19 @@ CanThrowResult Sema::canThrow(const Expr *E) {
     else if (isa<CXXPseudoDestructorExpr>(CE->getCallee()->IgnoreParens()))
       CT = CT_Cannot;
     else
-      CT = canCalleeThrow(*this, E, CE->getCalleeDecl());
+      CT = canCalleeThrow(S, E, CE->getCalleeDecl());
     if (CT == CT_Can)
       return CT;
-    return mergeCanThrow(CT, canSubExprsThrow(*this, E));
+    return mergeCanThrow(CT, canSubExprsThrow(S, E));
   }
 
   case Expr::CXXConstructExprClass:
   case Expr::CXXTemporaryObjectExprClass: {
-    CanThrowResult CT = canCalleeThrow(*this, E,
+    CanThrowResult CT = canCalleeThrow(S, E,
         cast<CXXConstructExpr>(E)->getConstructor());
     if (CT == CT_Can)
       return CT;
-    return mergeCanThrow(CT, canSubExprsThrow(*this, E));
+    return mergeCanThrow(CT, canSubExprsThrow(S, E));
   }
 
   case Expr::LambdaExprClass: {
@@ -949,7 +967,7 @@ CanThrowResult Sema::canThrow(const Expr *E) {
     for (LambdaExpr::capture_init_iterator Cap = Lambda->capture_init_begin(),
                                         CapEnd = Lambda->capture_init_end();
          Cap != CapEnd; ++Cap)
-      CT = mergeCanThrow(CT, canThrow(*Cap));
+      CT = mergeCanThrow(CT, S.canThrow(*Cap));
     return CT;
   }
 
@@ -958,10 +976,10 @@ CanThrowResult Sema::canThrow(const Expr *E) {
     if (E->isTypeDependent())
       CT = CT_Dependent;
     else
-      CT = canCalleeThrow(*this, E, cast<CXXNewExpr>(E)->getOperatorNew());
+      CT = canCalleeThrow(S, E, cast<CXXNewExpr>(E)->getOperatorNew());
     if (CT == CT_Can)
       return CT;
-    return mergeCanThrow(CT, canSubExprsThrow(*this, E));
+    return mergeCanThrow(CT, canSubExprsThrow(S, E));
   }
 
   case Expr::CXXDeleteExprClass: {
@@ -970,25 +988,25 @@ CanThrowResult Sema::canThrow(const Expr *E) {
     if (DTy.isNull() || DTy->isDependentType()) {
       CT = CT_Dependent;
     } else {
-      CT = canCalleeThrow(*this, E,
+      CT = canCalleeThrow(S, E,
                           cast<CXXDeleteExpr>(E)->getOperatorDelete());
       if (const RecordType *RT = DTy->getAs<RecordType>()) {
         const CXXRecordDecl *RD = cast<CXXRecordDecl>(RT->getDecl());
-        CT = mergeCanThrow(CT, canCalleeThrow(*this, E, RD->getDestructor()));
+        CT = mergeCanThrow(CT, canCalleeThrow(S, E, RD->getDestructor()));
       }
       if (CT == CT_Can)
         return CT;
     }
-    return mergeCanThrow(CT, canSubExprsThrow(*this, E));
+    return mergeCanThrow(CT, canSubExprsThrow(S, E));
   }
 
   case Expr::CXXBindTemporaryExprClass: {
     // The bound temporary has to be destroyed again, which might throw.
-    CanThrowResult CT = canCalleeThrow(*this, E,
+    CanThrowResult CT = canCalleeThrow(S, E,
       cast<CXXBindTemporaryExpr>(E)->getTemporary()->getDestructor());
     if (CT == CT_Can)
       return CT;
-    return mergeCanThrow(CT, canSubExprsThrow(*this, E));
+    return mergeCanThrow(CT, canSubExprsThrow(S, E));
   }
 
     // ObjC message sends are like function calls, but never have exception
@@ -1024,7 +1042,7 @@ CanThrowResult Sema::canThrow(const Expr *E) {
   case Expr::ParenListExprClass:
   case Expr::ShuffleVectorExprClass:
   case Expr::VAArgExprClass:
-    return canSubExprsThrow(*this, E);
+    return canSubExprsThrow(S, E);
 
     // Some might be dependent for other reasons.
   case Expr::ArraySubscriptExprClass:
@@ -1037,7 +1055,7 @@ CanThrowResult Sema::canThrow(const Expr *E) {
   case Expr::MaterializeTemporaryExprClass:
   case Expr::UnaryOperatorClass: {
     CanThrowResult CT = E->isTypeDependent() ? CT_Dependent : CT_Cannot;
-    return mergeCanThrow(CT, canSubExprsThrow(*this, E));
+    return mergeCanThrow(CT, canSubExprsThrow(S, E));
   }
 
     // FIXME: We should handle StmtExpr, but that opens a MASSIVE can of worms.
@@ -1047,12 +1065,12 @@ CanThrowResult Sema::canThrow(const Expr *E) {
   case Expr::ChooseExprClass:
     if (E->isTypeDependent() || E->isValueDependent())
       return CT_Dependent;
-    return canThrow(cast<ChooseExpr>(E)->getChosenSubExpr(Context));
+    return S.canThrow(cast<ChooseExpr>(E)->getChosenSubExpr(S.Context));
 
   case Expr::GenericSelectionExprClass:
     if (cast<GenericSelectionExpr>(E)->isResultDependent())
       return CT_Dependent;
-    return canThrow(cast<GenericSelectionExpr>(E)->getResultExpr());
+    return S.canThrow(cast<GenericSelectionExpr>(E)->getResultExpr());
 
     // Some expressions are always dependent.
   case Expr::CXXDependentScopeMemberExprClass:
@@ -1123,4 +1141,22 @@ CanThrowResult Sema::canThrow(const Expr *E) {
   llvm_unreachable("Bogus StmtClass");
 }
 
+CanThrowResult Sema::canThrow(const Expr *E) {
+  llvm::DenseMap<const Expr *, CanThrowResult>::iterator Known
+    = CanThrowCache.find(E);
+  if (Known != CanThrowCache.end())
+    return Known->second;
+
+  bool WasProvisional = CanThrowResultIsProvisional;
+  CanThrowResultIsProvisional = false;
+  CanThrowResult CT = computeCanThrow(*this, E);
+
+  // Expressions without subexpressions are cheap to check again, so only
+  // remember the results for the others.
+  if (!CanThrowResultIsProvisional && const_cast<Expr *>(E)->children())
+    CanThrowCache[E] = CT;
+  CanThrowResultIsProvisional |= WasProvisional;
+  return CT;
+}
+
 } // end namespace clang
@@ -41,6 +41,7 @@
 #include "clang/Sema/ScopeInfo.h"
 #include "clang/Sema/SemaFixItUtils.h"
 #include "clang/Sema/Template.h"
+#include "clang/Sema/TimeTrace.h"
 using namespace clang;
 using namespace sema;
 
@@ -10084,6 +10085,9 @@ ExprResult
 Sema::VerifyIntegerConstantExpression(Expr *E, llvm::APSInt *Result,
                                       VerifyICEDiagnoser &Diagnoser,
                                       bool AllowFold) {
+  sema::TimeTraceScope Trace(TimeTracer.get(),
+                             sema::TimeTrace::ConstantEvaluation,
+                             "integral constant expression");
   SourceLocation DiagLoc = E->getLocStart();
 
   if (getLangOpts().CPlusPlus11) {
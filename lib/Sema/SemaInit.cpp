@@ -175,6 +175,21 @@ class InitListChecker {
   llvm::DenseMap<InitListExpr *, InitListExpr *> SyntacticToSemantic;
   InitListExpr *FullyStructuredList;
 
+  /// \brief The conversion most recently applied to an integer literal that
+  /// initializes an element of an array of integers. Large tables of such
+  /// literals are common, and the conversion is the same for every literal
+  /// of the same type whose value fits in the element type.
+  struct {
+    /// \brief The type of the literal, or null if no conversion is known.
+    QualType FromType;
+    /// \brief The element type the literal initializes.
+    QualType ToType;
+    /// \brief The type of the implicit cast applied to the literal, or null
+    /// if the literal is used as-is.
+    QualType CastType;
+    CastKind Kind;
+  } LiteralConversion;
+
   void CheckImplicitInitList(const InitializedEntity &Entity,
                              InitListExpr *ParentIList, QualType T,
                              unsigned &Index, InitListExpr *StructuredList,
@@ -228,6 +243,12 @@ class InitListChecker {
                       bool SubobjectIsDesignatorContext, unsigned &Index,
                       InitListExpr *StructuredList,
                       unsigned &StructuredIndex);
+  bool CheckIntegerLiteralArrayElement(InitListExpr *IList,
+                                       QualType ElemType, unsigned &Index,
+                                       InitListExpr *StructuredList,
+                                       unsigned &StructuredIndex);
+  void RememberIntegerLiteralConversion(Expr *Literal, QualType ElemType,
+                                        Expr *Result);
   bool CheckDesignatedInitializer(const InitializedEntity &Entity,
                                   InitListExpr *IList, DesignatedInitExpr *DIE,
                                   unsigned DesigIdx,
@@ -473,6 +494,7 @@ InitListChecker::InitListChecker(Sema &S, const InitializedEntity &Entity,
                                  bool VerifyOnly, bool AllowBraceElision)
   : SemaRef(S), VerifyOnly(VerifyOnly), AllowBraceElision(AllowBraceElision) {
   hadError = false;
+  LiteralConversion.Kind = CK_NoOp;
 
   unsigned newIndex = 0;
   unsigned newStructuredIndex = 0;
@@ -1188,6 +1210,9 @@ void InitListChecker::CheckArrayType(const InitializedEntity &Entity,
   }
 
   QualType elementType = arrayType->getElementType();
+  bool IntegerElements = elementType->isIntegerType() &&
+                         !elementType->isBooleanType() &&
+                         !elementType->isEnumeralType();
   while (Index < IList->getNumInits()) {
     Expr *Init = IList->getInit(Index);
     if (DesignatedInitExpr *DIE = dyn_cast<DesignatedInitExpr>(Init)) {
@@ -1226,12 +1251,23 @@ void InitListChecker::CheckArrayType(const InitializedEntity &Entity,
     if (maxElementsKnown && elementIndex == maxElements)
       break;
 
-    InitializedEntity ElementEntity =
-      InitializedEntity::InitializeElement(SemaRef.Context, StructuredIndex,
-                                           Entity);
-    // Check this element.
-    CheckSubElementType(ElementEntity, IList, elementType, Index,
-                        StructuredList, StructuredIndex);
+    bool IsIntegerLiteral = IntegerElements &&
+      (isa<IntegerLiteral>(Init) || isa<CharacterLiteral>(Init));
+    if (!IsIntegerLiteral ||
+        !CheckIntegerLiteralArrayElement(IList, elementType, Index,
+                                         StructuredList, StructuredIndex)) {
+      InitializedEntity ElementEntity =
+        InitializedEntity::InitializeElement(SemaRef.Context, StructuredIndex,
+                                             Entity);
+      // Check this element.
+      bool HadErrorBefore = hadError;
+      unsigned ElementIndex = Index;
+      CheckSubElementType(ElementEntity, IList, elementType, Index,
+                          StructuredList, StructuredIndex);
+      if (IsIntegerLiteral && !HadErrorBefore && !hadError)
+        RememberIntegerLiteralConversion(Init, elementType,
+                                         IList->getInit(ElementIndex));
+    }
     ++elementIndex;
 
     // If the array is of incomplete type, keep track of the number of
@@ -1263,6 +1299,90 @@ void InitListChecker::CheckArrayType(const InitializedEntity &Entity,
   }
 }
 
+/// Determine whether the given integer value is unchanged by conversion to
+/// the integer type \p T.
+static bool isIntegerValueRepresentable(ASTContext &Context,
+                                        const llvm::APSInt &Value, QualType T) {
+  unsigned BitWidth = Context.getIntWidth(T);
+  if (Value.isUnsigned() || Value.isNonNegative()) {
+    if (T->isSignedIntegerOrEnumerationType())
+      --BitWidth;
+    return Value.getActiveBits() <= BitWidth;
+  }
+  if (!T->isSignedIntegerOrEnumerationType())
+    return false;
+  return Value.getMinSignedBits() <= BitWidth;
+}
+
+/// Try to check an integer literal that initializes an element of an array
+/// of integers by reusing the conversion that was applied to an earlier
+/// literal of the same type, rather than building an initialization
+/// sequence for it.
+///
+/// \returns true if the literal was checked, false if it must go through
+/// the general path.
+bool
+InitListChecker::CheckIntegerLiteralArrayElement(InitListExpr *IList,
+                                                 QualType ElemType,
+                                                 unsigned &Index,
+                                                 InitListExpr *StructuredList,
+                                                 unsigned &StructuredIndex) {
+  Expr *Init = IList->getInit(Index);
+  ASTContext &Context = SemaRef.Context;
+  if (LiteralConversion.FromType.isNull() ||
+      ElemType != LiteralConversion.ToType ||
+      !Context.hasSameType(Init->getType(), LiteralConversion.FromType))
+    return false;
+
+  // The conversion can only be reused for values that it leaves unchanged;
+  // any other value might be a narrowing conversion.
+  llvm::APSInt Value = Init->EvaluateKnownConstInt(Context);
+  if (!isIntegerValueRepresentable(Context, Value, ElemType))
+    return false;
+
+  if (!VerifyOnly) {
+    Expr *Result = Init;
+    if (!LiteralConversion.CastType.isNull()) {
+      Result = ImplicitCastExpr::Create(Context, LiteralConversion.CastType,
+                                        LiteralConversion.Kind, Init, 0,
+                                        VK_RValue);
+      IList->setInit(Index, Result);
+    }
+    UpdateStructuredListElement(StructuredList, StructuredIndex, Result);
+  }
+  ++Index;
+  return true;
+}
+
+/// Remember the conversion that the general path applied to an integer
+/// literal initializing an element of an array of integers, so that it can
+/// be reused for the following elements.
+void InitListChecker::RememberIntegerLiteralConversion(Expr *Literal,
+                                                       QualType ElemType,
+                                                       Expr *Result) {
+  ASTContext &Context = SemaRef.Context;
+  llvm::APSInt Value = Literal->EvaluateKnownConstInt(Context);
+  if (!isIntegerValueRepresentable(Context, Value, ElemType))
+    return;
+
+  QualType CastType;
+  CastKind Kind = CK_NoOp;
+  if (!VerifyOnly && Result != Literal) {
+    // Only a single implicit cast of the literal itself can be reused.
+    ImplicitCastExpr *Cast = dyn_cast<ImplicitCastExpr>(Result);
+    if (!Cast || Cast->getSubExpr() != Literal || Cast->path_size() ||
+        Cast->getValueKind() != VK_RValue)
+      return;
+    CastType = Cast->getType();
+    Kind = Cast->getCastKind();
+  }
+
+  LiteralConversion.FromType = Literal->getType();
+  LiteralConversion.ToType = ElemType;
+  LiteralConversion.CastType = CastType;
+  LiteralConversion.Kind = Kind;
+}
+
 bool InitListChecker::CheckFlexibleArrayInit(const InitializedEntity &Entity,
                                              Expr *InitExpr,
                                              FieldDecl *Field,
@@ -3754,9 +3754,42 @@ TypoCorrection Sema::CorrectTypo(const DeclarationNameInfo &TypoName,
   TypoCorrection EmptyCorrection;
   bool ValidatingCallback = !isCandidateViable(CCC, EmptyCorrection);
 
+  // Provide a stop gap for files that are just seriously broken.  Trying
+  // to correct all typos can turn into a HUGE performance penalty, causing
+  // some files to take minutes to get rejected by the parser.
+  unsigned Limit = getDiagnostics().getDiagnosticOptions().SpellCheckingLimit;
+
+  // Qualified and member lookups are cached per context searched.
+  DeclContext *QualifiedDC = MemberContext;
+  if (!MemberContext && SS && SS->isSet()) {
+    QualifiedDC = computeDeclContext(*SS, EnteringContext);
+    if (!QualifiedDC)
+      return TypoCorrection();
+  }
+  QualifiedTypoKey CacheKey(Typo, std::make_pair((DeclContext *)0,
+                                                 CurContext));
+  if (QualifiedDC && !OPT) {
+    CacheKey.second.first = QualifiedDC->getPrimaryContext();
+    QualifiedTyposCorrectedMap::iterator Cached
+      = QualifiedTyposCorrected.find(CacheKey);
+    if (Cached != QualifiedTyposCorrected.end()) {
+      // Reuse the cached correction if it is still acceptable here. Only
+      // honor no-correction cache hits when a callback that will validate
+      // correction candidates is not being used.
+      if (Cached->second) {
+        if (!Cached->second.isKeyword() &&
+            isCandidateViable(CCC, Cached->second)) {
+          TypoCorrection TC = Cached->second;
+          TC.setCorrectionRange(SS, TypoName);
+          return TC;
+        }
+      } else if (!ValidatingCallback)
+        return TypoCorrection();
+    }
+  }
+
   // Perform name lookup to find visible, similarly-named entities.
   bool IsUnqualifiedLookup = false;
-  DeclContext *QualifiedDC = MemberContext;
   if (MemberContext) {
     LookupVisibleDecls(MemberContext, LookupKind, Consumer);
 
@@ -3768,14 +3801,7 @@ TypoCorrection Sema::CorrectTypo(const DeclarationNameInfo &TypoName,
         LookupVisibleDecls(*I, LookupKind, Consumer);
     }
   } else if (SS && SS->isSet()) {
-    QualifiedDC = computeDeclContext(*SS, EnteringContext);
-    if (!QualifiedDC)
-      return TypoCorrection();
-
-    // Provide a stop gap for files that are just seriously broken.  Trying
-    // to correct all typos can turn into a HUGE performance penalty, causing
-    // some files to take minutes to get rejected by the parser.
-    if (TyposCorrected + UnqualifiedTyposCorrected.size() >= 20)
+    if (Limit && TyposCorrected + UnqualifiedTyposCorrected.size() >= Limit)
       return TypoCorrection();
     ++TyposCorrected;
 
@@ -3799,10 +3825,7 @@ TypoCorrection Sema::CorrectTypo(const DeclarationNameInfo &TypoName,
       }
     }
     if (Cached == UnqualifiedTyposCorrected.end()) {
-      // Provide a stop gap for files that are just seriously broken.  Trying
-      // to correct all typos can turn into a HUGE performance penalty, causing
-      // some files to take minutes to get rejected by the parser.
-      if (TyposCorrected + UnqualifiedTyposCorrected.size() >= 20)
+      if (Limit && TyposCorrected + UnqualifiedTyposCorrected.size() >= Limit)
         return TypoCorrection();
     }
   }
@@ -3826,17 +3849,33 @@ TypoCorrection Sema::CorrectTypo(const DeclarationNameInfo &TypoName,
       Consumer.FoundName(I->getKey());
 
     // Walk through identifiers in external identifier sources.
-    // FIXME: Re-add the ability to skip very unlikely potential corrections.
     if (IdentifierInfoLookup *External
                             = Context.Idents.getExternalIdentifierLookup()) {
-      OwningPtr<IdentifierIterator> Iter(External->getIdentifiers());
-      do {
-        StringRef Name = Iter->Next();
-        if (Name.empty())
-          break;
-
-        Consumer.FoundName(Name);
-      } while (true);
+      if (getLangOpts().Modules) {
+        // Modules can be imported at any point, so the set of external
+        // identifiers is not stable; walk all of them every time.
+        OwningPtr<IdentifierIterator> Iter(External->getIdentifiers());
+        do {
+          StringRef Name = Iter->Next();
+          if (Name.empty())
+            break;
+
+          Consumer.FoundName(Name);
+        } while (true);
+      } else {
+        // Only names whose length is close enough to the typo's can be
+        // acceptable corrections; see TypoCorrectionConsumer::FoundName.
+        LoadExternalTypoCandidates(External);
+        unsigned Size = Typo->getName().size();
+        unsigned MinSize = Size - Size / 3;
+        unsigned MaxSize = std::min<unsigned>(Size + Size / 3,
+                                              ExternalTypoCandidates.size() - 1);
+        for (unsigned Len = MinSize; Len <= MaxSize; ++Len) {
+          const std::vector<StringRef> &Names = ExternalTypoCandidates[Len];
+          for (unsigned I = 0, N = Names.size(); I != N; ++I)
+            Consumer.FoundName(Names[I]);
+        }
+      }
     }
   }
 
@@ -3844,9 +3883,11 @@ TypoCorrection Sema::CorrectTypo(const DeclarationNameInfo &TypoName,
 
   // If we haven't found anything, we're done.
   if (Consumer.empty()) {
-    // If this was an unqualified lookup, note that no correction was found.
+    // Note that no correction was found.
     if (IsUnqualifiedLookup)
       (void)UnqualifiedTyposCorrected[Typo];
+    else if (CacheKey.second.first)
+      (void)QualifiedTyposCorrected[CacheKey];
 
     return TypoCorrection();
   }
@@ -3855,9 +3896,11 @@ TypoCorrection Sema::CorrectTypo(const DeclarationNameInfo &TypoName,
   // is not more that about a third of the length of the typo's identifier.
   unsigned ED = Consumer.getBestEditDistance(true);
   if (ED > 0 && Typo->getName().size() / ED < 3) {
-    // If this was an unqualified lookup, note that no correction was found.
+    // Note that no correction was found.
     if (IsUnqualifiedLookup)
       (void)UnqualifiedTyposCorrected[Typo];
+    else if (CacheKey.second.first)
+      (void)QualifiedTyposCorrected[CacheKey];
 
     return TypoCorrection();
   }
@@ -4044,11 +4087,12 @@ TypoCorrection Sema::CorrectTypo(const DeclarationNameInfo &TypoName,
   ED = Consumer.getBestEditDistance(true);
 
   if (!AllowOnlyNNSChanges && ED > 0 && Typo->getName().size() / ED < 3) {
-    // If this was an unqualified lookup and we believe the callback
-    // object wouldn't have filtered out possible corrections, note
-    // that no correction was found.
+    // If we believe the callback object wouldn't have filtered out possible
+    // corrections, note that no correction was found.
     if (IsUnqualifiedLookup && !ValidatingCallback)
       (void)UnqualifiedTyposCorrected[Typo];
+    else if (CacheKey.second.first && !ValidatingCallback)
+      (void)QualifiedTyposCorrected[CacheKey];
 
     return TypoCorrection();
   }
@@ -4063,9 +4107,11 @@ TypoCorrection Sema::CorrectTypo(const DeclarationNameInfo &TypoName,
     // wasn't actually in scope.
     if (ED == 0 && Result.isKeyword()) return TypoCorrection();
 
-    // Record the correction for unqualified lookup.
+    // Record the correction for unqualified or qualified lookup.
     if (IsUnqualifiedLookup)
       UnqualifiedTyposCorrected[Typo] = Result;
+    else if (CacheKey.second.first)
+      QualifiedTyposCorrected[CacheKey] = Result;
 
     TypoCorrection TC = Result;
     TC.setCorrectionRange(SS, TypoName);
@@ -4094,14 +4140,38 @@ TypoCorrection Sema::CorrectTypo(const DeclarationNameInfo &TypoName,
     return TC;
   }
 
-  // If this was an unqualified lookup and we believe the callback object did
-  // not filter out possible corrections, note that no correction was found.
+  // If we believe the callback object did not filter out possible
+  // corrections, note that no correction was found.
   if (IsUnqualifiedLookup && !ValidatingCallback)
     (void)UnqualifiedTyposCorrected[Typo];
+  else if (CacheKey.second.first && !ValidatingCallback)
+    (void)QualifiedTyposCorrected[CacheKey];
 
   return TypoCorrection();
 }
 
+/// \brief Build the length-bucketed index of the identifiers provided by the
+/// given external identifier source, if it has not been built yet.
+void Sema::LoadExternalTypoCandidates(IdentifierInfoLookup *External) {
+  if (LoadedExternalTypoCandidates)
+    return;
+  LoadedExternalTypoCandidates = true;
+
+  OwningPtr<IdentifierIterator> Iter(External->getIdentifiers());
+  do {
+    StringRef Name = Iter->Next();
+    if (Name.empty())
+      break;
+
+    if (Name.size() >= ExternalTypoCandidates.size())
+      ExternalTypoCandidates.resize(Name.size() + 1);
+    ExternalTypoCandidates[Name.size()].push_back(Name);
+  } while (true);
+
+  if (ExternalTypoCandidates.empty())
+    ExternalTypoCandidates.resize(1);
+}
+
 void TypoCorrection::addCorrectionDecl(NamedDecl *CDecl) {
   if (!CDecl) return;
 
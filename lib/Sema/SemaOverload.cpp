@@ -27,6 +27,7 @@
 #include "clang/Sema/SemaInternal.h"
 #include "clang/Sema/Template.h"
 #include "clang/Sema/TemplateDeduction.h"
+#include "clang/Sema/TimeTrace.h"
 #include "llvm/ADT/DenseSet.h"
 #include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/SmallPtrSet.h"
@@ -9988,6 +9989,10 @@ ExprResult Sema::BuildOverloadedCallExpr(Scope *S, Expr *Fn,
                                          SourceLocation RParenLoc,
                                          Expr *ExecConfig,
                                          bool AllowTypoCorrection) {
+  sema::TimeTraceScope Trace(TimeTracer.get(),
+                             sema::TimeTrace::OverloadResolution,
+                             TimeTracer ? ULE->getName().getAsString()
+                                        : std::string());
   OverloadCandidateSet CandidateSet(Fn->getExprLoc());
   ExprResult result;
 
@@ -10038,6 +10043,10 @@ Sema::CreateOverloadedUnaryOp(SourceLocation OpLoc, unsigned OpcIn,
   // TODO: provide better source location info.
   DeclarationNameInfo OpNameInfo(OpName, OpLoc);
 
+  sema::TimeTraceScope Trace(TimeTracer.get(),
+                             sema::TimeTrace::OverloadResolution,
+                             TimeTracer ? OpName.getAsString() : std::string());
+
   if (checkPlaceholderForOverload(*this, Input))
     return ExprError();
 
@@ -10236,6 +10245,10 @@ Sema::CreateOverloadedBinOp(SourceLocation OpLoc,
   OverloadedOperatorKind Op = BinaryOperator::getOverloadedOperator(Opc);
   DeclarationName OpName = Context.DeclarationNames.getCXXOperatorName(Op);
 
+  sema::TimeTraceScope Trace(TimeTracer.get(),
+                             sema::TimeTrace::OverloadResolution,
+                             TimeTracer ? OpName.getAsString() : std::string());
+
   // If either side is type-dependent, create an appropriate dependent
   // expression.
   if (Args[0]->isTypeDependent() || Args[1]->isTypeDependent()) {
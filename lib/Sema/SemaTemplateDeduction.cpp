@@ -3033,6 +3033,131 @@ DeduceTemplateArgumentByListElement(Sema &S,
                                             ArgType, Info, Deduced, TDF);
 }
 
+/// \brief Classify the type of a function parameter of the given function
+/// template, for template argument deduction from a call.
+static FunctionTemplateDecl::CallParamShape
+getCallParamShape(Sema &S, FunctionTemplateDecl *FunctionTemplate,
+                  QualType ParamType) {
+  if (!hasDeducibleTemplateParameters(S, FunctionTemplate, ParamType))
+    return FunctionTemplateDecl::CPS_NonDeduced;
+
+  unsigned Depth = FunctionTemplate->getTemplateParameters()->getDepth();
+  FunctionTemplateDecl::CallParamShape Shape
+    = FunctionTemplateDecl::CPS_TypeParm;
+  QualType T = S.Context.getCanonicalType(ParamType);
+  if (const LValueReferenceType *Ref = dyn_cast<LValueReferenceType>(T)) {
+    T = Ref->getPointeeType();
+    Shape = FunctionTemplateDecl::CPS_LValueRefToTypeParm;
+    // Only cv-qualifiers are handled by the fast path.
+    if (T.getQualifiers().hasNonFastQualifiers())
+      return FunctionTemplateDecl::CPS_General;
+  }
+
+  const TemplateTypeParmType *TTP
+    = dyn_cast<TemplateTypeParmType>(T.getTypePtr());
+  if (!TTP || TTP->getDepth() != Depth || TTP->isParameterPack())
+    return FunctionTemplateDecl::CPS_General;
+  return Shape;
+}
+
+/// \brief Retrieve the shapes of the function parameters of the given
+/// function template, computing them if this is the first time the template
+/// has been named in a call.
+static const unsigned char *
+getCallParamShapes(Sema &S, FunctionTemplateDecl *FunctionTemplate) {
+  if (const unsigned char *Shapes = FunctionTemplate->getCallParamShapes())
+    return Shapes;
+
+  FunctionDecl *Function = FunctionTemplate->getTemplatedDecl();
+  unsigned NumParams = Function->getNumParams();
+  if (NumParams == 0)
+    return 0;
+
+  unsigned char *Shapes = new (S.Context) unsigned char [NumParams];
+  for (unsigned I = 0; I != NumParams; ++I)
+    Shapes[I] = getCallParamShape(S, FunctionTemplate,
+                                  Function->getParamDecl(I)->getType());
+  FunctionTemplate->setCallParamShapes(Shapes);
+  return Shapes;
+}
+
+/// \brief Deduce the template argument for a function parameter of the form
+/// "cv T" or "cv T&" from the corresponding call argument, without going
+/// through the general machinery of DeduceTemplateArgumentsByTypeMatch.
+///
+/// \param ArgType the type of the argument, which will be adjusted as
+/// described in C++ [temp.deduct.call]p2 and p3.
+///
+/// \returns true if the argument was handled, in which case \p Result holds
+/// the result of deduction, or false if the general path must be used.
+static bool
+DeduceTemplateArgumentsByShape(Sema &S, TemplateParameterList *TemplateParams,
+                               FunctionTemplateDecl::CallParamShape Shape,
+                               QualType ParamType, Expr *Arg,
+                               QualType &ArgType, TemplateDeductionInfo &Info,
+                              SmallVectorImpl<DeducedTemplateArgument> &Deduced,
+                               Sema::TemplateDeductionResult &Result) {
+  // Overload sets, other placeholders and initializer lists need the special
+  // handling of the general path.
+  if (ArgType->isPlaceholderType() || isa<InitListExpr>(Arg))
+    return false;
+
+  QualType CanonParam = S.Context.getCanonicalType(ParamType);
+  Qualifiers ParamQs;
+  if (Shape == FunctionTemplateDecl::CPS_LValueRefToTypeParm) {
+    CanonParam = cast<LValueReferenceType>(CanonParam)->getPointeeType();
+    ParamQs = CanonParam.getQualifiers();
+  }
+  unsigned Index = cast<TemplateTypeParmType>(CanonParam)->getIndex();
+
+  QualType DeducedType;
+  if (Shape == FunctionTemplateDecl::CPS_TypeParm) {
+    // C++ [temp.deduct.call]p2:
+    //   If P is not a reference type, arrays and functions decay to pointers,
+    //   and top-level cv-qualifiers of A are ignored.
+    QualType AdjustedArgType;
+    if (ArgType->isArrayType())
+      AdjustedArgType = S.Context.getArrayDecayedType(ArgType);
+    else if (ArgType->isFunctionType())
+      AdjustedArgType = S.Context.getPointerType(ArgType);
+    else
+      AdjustedArgType = ArgType.getUnqualifiedType();
+    DeducedType = S.Context.getCanonicalType(AdjustedArgType);
+    if (S.getLangOpts().ObjCAutoRefCount && DeducedType->isObjCLifetimeType())
+      return false;
+    ArgType = AdjustedArgType;
+  } else {
+    // C++ [temp.deduct.call]p3:
+    //   If P is a reference type, the type referred to by P is used for type
+    //   deduction, and the deduced A can be more cv-qualified than A.
+    DeducedType = S.Context.getCanonicalType(ArgType);
+    if (DeducedType->isArrayType() ||
+        DeducedType.getQualifiers().hasNonFastQualifiers() ||
+        (S.getLangOpts().ObjCAutoRefCount &&
+         DeducedType->isObjCLifetimeType()))
+      return false;
+    Qualifiers DeducedQs = DeducedType.getQualifiers();
+    DeducedQs.removeCVRQualifiers(ParamQs.getCVRQualifiers());
+    DeducedType = S.Context.getQualifiedType(DeducedType.getUnqualifiedType(),
+                                             DeducedQs);
+  }
+
+  DeducedTemplateArgument NewDeduced(DeducedType);
+  DeducedTemplateArgument Merged
+    = checkDeducedTemplateArguments(S.Context, Deduced[Index], NewDeduced);
+  if (Merged.isNull()) {
+    Info.Param = cast<TemplateTypeParmDecl>(TemplateParams->getParam(Index));
+    Info.FirstArg = Deduced[Index];
+    Info.SecondArg = NewDeduced;
+    Result = Sema::TDK_Inconsistent;
+    return true;
+  }
+
+  Deduced[Index] = Merged;
+  Result = Sema::TDK_Success;
+  return true;
+}
+
 /// \brief Perform template argument deduction from a function call
 /// (C++ [temp.deduct.call]).
 ///
@@ -3107,6 +3232,13 @@ Sema::DeduceTemplateArguments(FunctionTemplateDecl *FunctionTemplate,
       ParamTypes.push_back(Function->getParamDecl(I)->getType());
   }
 
+  // When the parameter types come straight from the declaration, the shapes
+  // of the parameters can be used to take a fast path through deduction for
+  // the common cases.
+  const unsigned char *ParamShapes = 0;
+  if (!ExplicitTemplateArgs)
+    ParamShapes = getCallParamShapes(*this, FunctionTemplate);
+
   // Deduce template arguments from the function parameters.
   Deduced.resize(TemplateParams->size());
   unsigned ArgIdx = 0;
@@ -3125,7 +3257,26 @@ Sema::DeduceTemplateArguments(FunctionTemplateDecl *FunctionTemplate,
 
       Expr *Arg = Args[ArgIdx++];
       QualType ArgType = Arg->getType();
-      
+
+      if (ParamShapes) {
+        FunctionTemplateDecl::CallParamShape Shape
+          = FunctionTemplateDecl::CallParamShape(ParamShapes[ParamIdx]);
+        if (Shape == FunctionTemplateDecl::CPS_NonDeduced)
+          continue;
+
+        TemplateDeductionResult Result;
+        if (Shape != FunctionTemplateDecl::CPS_General &&
+            DeduceTemplateArgumentsByShape(*this, TemplateParams, Shape,
+                                           ParamType, Arg, ArgType, Info,
+                                           Deduced, Result)) {
+          if (Result)
+            return Result;
+          OriginalCallArgs.push_back(OriginalCallArg(OrigParamType, ArgIdx-1,
+                                                     ArgType));
+          continue;
+        }
+      }
+
       unsigned TDF = 0;
       if (AdjustFunctionParmAndArgTypesForDeduction(*this, TemplateParams,
                                                     ParamType, ArgType, Arg,
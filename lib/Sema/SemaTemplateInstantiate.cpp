@@ -22,6 +22,7 @@
 #include "clang/Sema/Lookup.h"
 #include "clang/Sema/Template.h"
 #include "clang/Sema/TemplateDeduction.h"
+#include "clang/Sema/TimeTrace.h"
 
 using namespace clang;
 using namespace sema;
@@ -187,7 +188,7 @@ InstantiatingTemplate(Sema &SemaRef, SourceLocation PointOfInstantiation,
     Inst.NumTemplateArgs = 0;
     Inst.InstantiationRange = InstantiationRange;
     SemaRef.InNonInstantiationSFINAEContext = false;
-    SemaRef.ActiveTemplateInstantiations.push_back(Inst);
+    Push(Inst);
   }
 }
 
@@ -210,7 +211,7 @@ InstantiatingTemplate(Sema &SemaRef, SourceLocation PointOfInstantiation,
     Inst.NumTemplateArgs = 0;
     Inst.InstantiationRange = InstantiationRange;
     SemaRef.InNonInstantiationSFINAEContext = false;
-    SemaRef.ActiveTemplateInstantiations.push_back(Inst);
+    Push(Inst);
   }
 }
 
@@ -235,7 +236,7 @@ InstantiatingTemplate(Sema &SemaRef, SourceLocation PointOfInstantiation,
     Inst.NumTemplateArgs = TemplateArgs.size();
     Inst.InstantiationRange = InstantiationRange;
     SemaRef.InNonInstantiationSFINAEContext = false;
-    SemaRef.ActiveTemplateInstantiations.push_back(Inst);
+    Push(Inst);
   }
 }
 
@@ -261,7 +262,7 @@ InstantiatingTemplate(Sema &SemaRef, SourceLocation PointOfInstantiation,
     Inst.DeductionInfo = &DeductionInfo;
     Inst.InstantiationRange = InstantiationRange;
     SemaRef.InNonInstantiationSFINAEContext = false;
-    SemaRef.ActiveTemplateInstantiations.push_back(Inst);
+    Push(Inst);
     
     if (!Inst.isInstantiationRecord())
       ++SemaRef.NonInstantiationEntries;
@@ -289,7 +290,7 @@ InstantiatingTemplate(Sema &SemaRef, SourceLocation PointOfInstantiation,
     Inst.DeductionInfo = &DeductionInfo;
     Inst.InstantiationRange = InstantiationRange;
     SemaRef.InNonInstantiationSFINAEContext = false;
-    SemaRef.ActiveTemplateInstantiations.push_back(Inst);
+    Push(Inst);
   }
 }
 
@@ -313,7 +314,7 @@ InstantiatingTemplate(Sema &SemaRef, SourceLocation PointOfInstantiation,
     Inst.NumTemplateArgs = TemplateArgs.size();
     Inst.InstantiationRange = InstantiationRange;
     SemaRef.InNonInstantiationSFINAEContext = false;
-    SemaRef.ActiveTemplateInstantiations.push_back(Inst);
+    Push(Inst);
   }
 }
 
@@ -337,7 +338,7 @@ InstantiatingTemplate(Sema &SemaRef, SourceLocation PointOfInstantiation,
     Inst.NumTemplateArgs = TemplateArgs.size();
     Inst.InstantiationRange = InstantiationRange;
     SemaRef.InNonInstantiationSFINAEContext = false;
-    SemaRef.ActiveTemplateInstantiations.push_back(Inst);
+    Push(Inst);
   }
 }
 
@@ -361,7 +362,7 @@ InstantiatingTemplate(Sema &SemaRef, SourceLocation PointOfInstantiation,
     Inst.NumTemplateArgs = TemplateArgs.size();
     Inst.InstantiationRange = InstantiationRange;
     SemaRef.InNonInstantiationSFINAEContext = false;
-    SemaRef.ActiveTemplateInstantiations.push_back(Inst);
+    Push(Inst);
   }
 }
 
@@ -385,7 +386,7 @@ InstantiatingTemplate(Sema &SemaRef, SourceLocation PointOfInstantiation,
   Inst.NumTemplateArgs = TemplateArgs.size();
   Inst.InstantiationRange = InstantiationRange;
   SemaRef.InNonInstantiationSFINAEContext = false;
-  SemaRef.ActiveTemplateInstantiations.push_back(Inst);
+  Push(Inst);
   
   assert(!Inst.isInstantiationRecord());
   ++SemaRef.NonInstantiationEntries;
@@ -400,10 +401,65 @@ void Sema::InstantiatingTemplate::Clear() {
     SemaRef.InNonInstantiationSFINAEContext
       = SavedInNonInstantiationSFINAEContext;
     SemaRef.ActiveTemplateInstantiations.pop_back();
+    if (SemaRef.TimeTracer)
+      SemaRef.TimeTracer->end();
     Invalid = true;
   }
 }
 
+/// \brief Describe an active template instantiation for the time trace.
+static std::string
+getTimeTraceName(Sema &S, const Sema::ActiveTemplateInstantiation &Inst) {
+  std::string Name;
+  llvm::raw_string_ostream OS(Name);
+  PrintingPolicy Policy = S.getPrintingPolicy();
+
+  switch (Inst.Kind) {
+  case Sema::ActiveTemplateInstantiation::TemplateInstantiation:
+    OS << "instantiate ";
+    break;
+  case Sema::ActiveTemplateInstantiation::ExceptionSpecInstantiation:
+    OS << "instantiate exception specification of ";
+    break;
+  case Sema::ActiveTemplateInstantiation::DefaultTemplateArgumentInstantiation:
+    OS << "instantiate default template argument of ";
+    break;
+  case Sema::ActiveTemplateInstantiation::DefaultFunctionArgumentInstantiation:
+    OS << "instantiate default function argument ";
+    break;
+  case Sema::ActiveTemplateInstantiation::ExplicitTemplateArgumentSubstitution:
+    OS << "substitute explicit template arguments into ";
+    break;
+  case Sema::ActiveTemplateInstantiation::DeducedTemplateArgumentSubstitution:
+    OS << "deduce template arguments for ";
+    break;
+  case Sema::ActiveTemplateInstantiation::PriorTemplateArgumentSubstitution:
+    OS << "substitute prior template arguments into ";
+    break;
+  case Sema::ActiveTemplateInstantiation::DefaultTemplateArgumentChecking:
+    OS << "check default template argument ";
+    break;
+  }
+
+  if (const NamedDecl *ND = dyn_cast_or_null<NamedDecl>(Inst.Entity))
+    ND->getNameForDiagnostic(OS, Policy, /*Qualified=*/true);
+  if (Inst.NumTemplateArgs &&
+      Inst.Kind != Sema::ActiveTemplateInstantiation::TemplateInstantiation)
+    TemplateSpecializationType::PrintTemplateArgumentList(OS,
+                                                          Inst.TemplateArgs,
+                                                          Inst.NumTemplateArgs,
+                                                          Policy);
+  return OS.str();
+}
+
+void
+Sema::InstantiatingTemplate::Push(const ActiveTemplateInstantiation &Inst) {
+  SemaRef.ActiveTemplateInstantiations.push_back(Inst);
+  if (SemaRef.TimeTracer)
+    SemaRef.TimeTracer->begin(sema::TimeTrace::TemplateInstantiation,
+                              getTimeTraceName(SemaRef, Inst));
+}
+
 bool Sema::InstantiatingTemplate::CheckInstantiationDepth(
                                         SourceLocation PointOfInstantiation,
                                            SourceRange InstantiationRange) {
@@ -3637,8 +3637,23 @@ void Sema::PerformPendingInstantiations(bool LocalOnly) {
       PendingLocalImplicitInstantiations.pop_front();
     }
 
+    // Remember what a precompiled header instantiated, so that importers can
+    // reuse the definitions.
+    if (TUKind == TU_Prefix && LangOpts.PCHInstantiateTemplates)
+      PrefixInstantiations.push_back(Inst);
+
     // Instantiate function definitions
     if (FunctionDecl *Function = dyn_cast<FunctionDecl>(Inst.first)) {
+      // If the definition was already instantiated in an AST file, reuse it.
+      // The AST consumer has not seen it yet in this translation unit.
+      const FunctionDecl *Definition = 0;
+      if (Function->isDefined(Definition) && Definition->isFromASTFile()) {
+        if (ReusedASTFileInstantiations.insert(Definition))
+          Consumer.HandleTopLevelDecl(
+            DeclGroupRef(const_cast<FunctionDecl *>(Definition)));
+        continue;
+      }
+
       PrettyDeclStackTraceEntry CrashInfo(*this, Function, SourceLocation(),
                                           "instantiating function definition");
       bool DefinitionRequired = Function->getTemplateSpecializationKind() ==
@@ -0,0 +1,98 @@
+//===--- TimeTrace.cpp - Profiling of semantic analysis ---------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+//  This file implements the TimeTrace class, which records a trace of the
+//  expensive parts of semantic analysis.
+//
+//===----------------------------------------------------------------------===//
+
+#include "clang/Sema/TimeTrace.h"
+#include "llvm/Support/ErrorHandling.h"
+#include "llvm/Support/Format.h"
+#include "llvm/Support/raw_ostream.h"
+using namespace clang;
+using namespace sema;
+
+TimeTrace::TimeTrace() : Origin(llvm::TimeRecord::getCurrentTime(true)) { }
+
+void TimeTrace::begin(EventKind Kind, StringRef Name) {
+  OpenEvent E;
+  E.Kind = Kind;
+  E.Name = Name;
+  Stack.push_back(E);
+  // Read the clock last, so that the bookkeeping above is not attributed to
+  // the activity.
+  Stack.back().Start = llvm::TimeRecord::getCurrentTime(true);
+}
+
+void TimeTrace::end() {
+  llvm::TimeRecord Now = llvm::TimeRecord::getCurrentTime(false);
+  assert(!Stack.empty() && "Unbalanced TimeTrace::end()");
+  OpenEvent &Open = Stack.back();
+
+  Event E;
+  E.Kind = Open.Kind;
+  E.Name.swap(Open.Name);
+  E.Start = Open.Start.getWallTime() - Origin.getWallTime();
+  E.Duration = Now.getWallTime() - Open.Start.getWallTime();
+  E.MemoryDelta = Now.getMemUsed() - Open.Start.getMemUsed();
+  E.Depth = Stack.size() - 1;
+  Events.push_back(E);
+  Stack.pop_back();
+}
+
+const char *TimeTrace::getKindName(EventKind Kind) {
+  switch (Kind) {
+  case TemplateInstantiation: return "Template Instantiation";
+  case OverloadResolution:    return "Overload Resolution";
+  case ConstantEvaluation:    return "Constant Evaluation";
+  }
+
+  llvm_unreachable("Invalid EventKind!");
+}
+
+/// \brief Write the given string as a JSON string literal.
+static void writeJSONString(raw_ostream &OS, StringRef Str) {
+  OS << '"';
+  for (StringRef::iterator I = Str.begin(), E = Str.end(); I != E; ++I) {
+    unsigned char C = *I;
+    switch (C) {
+    case '"':  OS << "\\\""; break;
+    case '\\': OS << "\\\\"; break;
+    case '\n': OS << "\\n"; break;
+    case '\t': OS << "\\t"; break;
+    default:
+      if (C < 0x20)
+        OS << llvm::format("\\u%04x", C);
+      else
+        OS << C;
+      break;
+    }
+  }
+  OS << '"';
+}
+
+void TimeTrace::writeJSON(raw_ostream &OS) const {
+  OS << "{\n\"traceEvents\": [";
+  for (unsigned I = 0, N = Events.size(); I != N; ++I) {
+    const Event &E = Events[I];
+    if (I)
+      OS << ',';
+    OS << "\n{\"name\": ";
+    writeJSONString(OS, E.Name);
+    OS << ", \"cat\": ";
+    writeJSONString(OS, getKindName(E.Kind));
+    OS << ", \"ph\": \"X\", \"pid\": 1, \"tid\": 0"
+       << ", \"ts\": " << uint64_t(E.Start * 1000000.0)
+       << ", \"dur\": " << uint64_t(E.Duration * 1000000.0)
+       << ", \"args\": {\"depth\": " << E.Depth
+       << ", \"memory\": " << E.MemoryDelta << "}}";
+  }
+  OS << "\n],\n\"displayTimeUnit\": \"ms\"\n}\n";
+}
@@ -22,7 +22,9 @@
 #include "clang/AST/NestedNameSpecifier.h"
 #include "clang/AST/Type.h"
 #include "clang/AST/TypeLocVisitor.h"
+#include "clang/AST/VTableBuilder.h"
 #include "clang/Basic/FileManager.h"
+#include "clang/Basic/MemoryReport.h"
 #include "clang/Basic/SourceManager.h"
 #include "clang/Basic/SourceManagerInternals.h"
 #include "clang/Basic/TargetInfo.h"
@@ -37,6 +39,7 @@
 #include "clang/Lex/PreprocessorOptions.h"
 #include "clang/Sema/Scope.h"
 #include "clang/Sema/Sema.h"
+#include "clang/Sema/SemaDiagnostic.h"
 #include "clang/Serialization/ASTDeserializationListener.h"
 #include "clang/Serialization/GlobalModuleIndex.h"
 #include "clang/Serialization/ModuleManager.h"
@@ -44,6 +47,7 @@
 #include "llvm/ADT/Hashing.h"
 #include "llvm/ADT/StringExtras.h"
 #include "llvm/Bitcode/BitstreamReader.h"
+#include "llvm/Support/Capacity.h"
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/MemoryBuffer.h"
@@ -2560,6 +2564,60 @@ bool ASTReader::ReadASTBlock(ModuleFile &F) {
       }
       break;
 
+    case RECORD_LAYOUTS:
+      for (unsigned I = 0, N = Record.size(); I != N; /* in loop */) {
+        if (N - I < 4) {
+          Error("invalid record layouts record");
+          return true;
+        }
+        SerializedRecordLayout &Layout
+          = RecordLayouts[getGlobalDeclID(F, Record[I++])];
+        Layout.Size = Record[I++];
+        Layout.Alignment = Record[I++];
+        unsigned NumFields = Record[I++];
+        if (N - I < NumFields + 1) {
+          Error("invalid record layouts record");
+          return true;
+        }
+        Layout.FieldOffsets.assign(Record.begin() + I,
+                                   Record.begin() + I + NumFields);
+        I += NumFields;
+
+        unsigned NumBases = Record[I++];
+        if ((N - I) / 2 < NumBases) {
+          Error("invalid record layouts record");
+          return true;
+        }
+        Layout.BaseOffsets.clear();
+        for (unsigned B = 0; B != NumBases; ++B) {
+          DeclID Base = getGlobalDeclID(F, Record[I++]);
+          Layout.BaseOffsets.push_back(std::make_pair(Base, Record[I++]));
+        }
+      }
+      break;
+
+    case VTABLE_LAYOUTS:
+      for (unsigned I = 0, N = Record.size(); I != N; /* in loop */) {
+        if (N - I < 2) {
+          Error("invalid vtable layouts record");
+          return true;
+        }
+        SerializedVTableLayout &Layout
+          = VTableLayouts[getGlobalDeclID(F, Record[I++])];
+        unsigned Length = Record[I++];
+        if (N - I < Length) {
+          Error("invalid vtable layouts record");
+          return true;
+        }
+        Layout.F = &F;
+        Layout.Offset = VTableLayoutData.size();
+        Layout.Length = Length;
+        VTableLayoutData.append(Record.begin() + I,
+                                Record.begin() + I + Length);
+        I += Length;
+      }
+      break;
+
     case IMPORTED_MODULES: {
       if (F.Kind != MK_Module) {
         // If we aren't loading a module (which has its own exports), make
@@ -5706,6 +5764,14 @@ void ASTReader::PrintStats() {
     std::fprintf(stderr, "  %u/%u selectors read (%f%%)\n",
                  NumSelectorsLoaded, (unsigned)SelectorsLoaded.size(),
                  ((float)NumSelectorsLoaded/SelectorsLoaded.size() * 100));
+  if (!RecordLayouts.empty())
+    std::fprintf(stderr, "  %u/%u record layouts reused (%f%%)\n",
+                 NumRecordLayoutsReused, (unsigned)RecordLayouts.size(),
+                 ((float)NumRecordLayoutsReused/RecordLayouts.size() * 100));
+  if (!VTableLayouts.empty())
+    std::fprintf(stderr, "  %u/%u vtable layouts reused (%f%%)\n",
+                 NumVTableLayoutsReused, (unsigned)VTableLayouts.size(),
+                 ((float)NumVTableLayoutsReused/VTableLayouts.size() * 100));
   if (TotalNumStatements)
     std::fprintf(stderr, "  %u/%u statements read (%f%%)\n",
                  NumStatementsRead, TotalNumStatements,
@@ -5815,6 +5881,30 @@ void ASTReader::getMemoryBufferSizes(MemoryBufferSizes &sizes) const {
   }
 }
 
+void ASTReader::reportMemoryUsage(MemoryReport &Report) const {
+  for (ModuleConstIterator I = ModuleMgr.begin(),
+      E = ModuleMgr.end(); I != E; ++I) {
+    const ModuleFile &F = **I;
+    Report.add("ASTFiles", F.FileName, F.LocalNumDecls,
+               F.Buffer ? F.Buffer->getBufferSize() : 0);
+  }
+
+  unsigned NumDeclsLoaded
+    = DeclsLoaded.size() - std::count(DeclsLoaded.begin(), DeclsLoaded.end(),
+                                      (Decl *)0);
+  Report.add("ASTReader", "declaration table", NumDeclsLoaded,
+             llvm::capacity_in_bytes(DeclsLoaded));
+  Report.add("ASTReader", "type table", TypesLoaded.size(),
+             llvm::capacity_in_bytes(TypesLoaded));
+  Report.add("ASTReader", "identifier table", IdentifiersLoaded.size(),
+             llvm::capacity_in_bytes(IdentifiersLoaded));
+  Report.add("ASTReader", "macro table", MacrosLoaded.size(),
+             llvm::capacity_in_bytes(MacrosLoaded));
+  Report.add("ASTReader", "vtable layouts", VTableLayouts.size(),
+             VTableLayouts.getMemorySize() +
+             llvm::capacity_in_bytes(VTableLayoutData));
+}
+
 void ASTReader::InitializeSema(Sema &S) {
   SemaObj = &S;
   S.addExternalSource(this);
@@ -6049,6 +6139,152 @@ void ASTReader::ReadUndefinedButUsed(
   }
 }
 
+bool ASTReader::layoutRecordType(const RecordDecl *Record,
+                                 uint64_t &Size, uint64_t &Alignment,
+                      llvm::DenseMap<const FieldDecl *, uint64_t> &FieldOffsets,
+                 llvm::DenseMap<const CXXRecordDecl *, CharUnits> &BaseOffsets,
+         llvm::DenseMap<const CXXRecordDecl *, CharUnits> &VirtualBaseOffsets) {
+  if (!Record->isFromASTFile())
+    return false;
+
+  llvm::DenseMap<DeclID, SerializedRecordLayout>::iterator Known
+    = RecordLayouts.find(Record->getGlobalID());
+  if (Known == RecordLayouts.end())
+    return false;
+  const SerializedRecordLayout &Layout = Known->second;
+
+  // Laying the record out would check it for padding and unnecessary
+  // packing; do so if anyone is listening.
+  SourceLocation Loc = Record->getLocation();
+  if (Diags.getDiagnosticLevel(diag::warn_padded_struct_field, Loc) !=
+        DiagnosticsEngine::Ignored ||
+      Diags.getDiagnosticLevel(diag::warn_padded_struct_anon_field, Loc) !=
+        DiagnosticsEngine::Ignored ||
+      Diags.getDiagnosticLevel(diag::warn_padded_struct_size, Loc) !=
+        DiagnosticsEngine::Ignored ||
+      Diags.getDiagnosticLevel(diag::warn_unnecessary_packed, Loc) !=
+        DiagnosticsEngine::Ignored)
+    return false;
+
+  // The record must have the fields it had when it was laid out.
+  unsigned NumFields = 0;
+  for (RecordDecl::field_iterator F = Record->field_begin(),
+                               FEnd = Record->field_end();
+       F != FEnd; ++F, ++NumFields) {
+    if (NumFields == Layout.FieldOffsets.size())
+      return false;
+    FieldOffsets[*F] = Layout.FieldOffsets[NumFields];
+  }
+  if (NumFields != Layout.FieldOffsets.size())
+    return false;
+
+  for (unsigned I = 0, N = Layout.BaseOffsets.size(); I != N; ++I)
+    BaseOffsets[cast<CXXRecordDecl>(GetDecl(Layout.BaseOffsets[I].first))]
+      = CharUnits::fromQuantity(Layout.BaseOffsets[I].second);
+
+  Size = Layout.Size;
+  Alignment = Layout.Alignment;
+  ++NumRecordLayoutsReused;
+  return true;
+}
+
+/// \brief Read a thunk adjustment written by AddThunkInfo.
+static ThunkInfo ReadThunkInfo(const uint64_t *Data, unsigned &Idx) {
+  ThunkInfo Thunk;
+  Thunk.This.NonVirtual = Data[Idx++];
+  Thunk.This.VCallOffsetOffset = Data[Idx++];
+  Thunk.Return.NonVirtual = Data[Idx++];
+  Thunk.Return.VBaseOffsetOffset = Data[Idx++];
+  return Thunk;
+}
+
+bool ASTReader::layoutVTable(const CXXRecordDecl *RD, VTableLayoutInfo &Info) {
+  if (!RD->isFromASTFile())
+    return false;
+
+  llvm::DenseMap<DeclID, SerializedVTableLayout>::iterator Known
+    = VTableLayouts.find(RD->getGlobalID());
+  if (Known == VTableLayouts.end())
+    return false;
+  ModuleFile &F = *Known->second.F;
+  const uint64_t *Data = VTableLayoutData.data() + Known->second.Offset;
+  unsigned Idx = 0;
+
+  unsigned NumComponents = Data[Idx++];
+  for (unsigned I = 0; I != NumComponents; ++I) {
+    VTableComponent::Kind Kind = VTableComponent::Kind(Data[Idx++]);
+    uint64_t Value = Data[Idx++];
+    switch (Kind) {
+    case VTableComponent::CK_VCallOffset:
+      Info.Components.push_back(VTableComponent::MakeVCallOffset(
+                                  CharUnits::fromQuantity(Value)));
+      break;
+    case VTableComponent::CK_VBaseOffset:
+      Info.Components.push_back(VTableComponent::MakeVBaseOffset(
+                                  CharUnits::fromQuantity(Value)));
+      break;
+    case VTableComponent::CK_OffsetToTop:
+      Info.Components.push_back(VTableComponent::MakeOffsetToTop(
+                                  CharUnits::fromQuantity(Value)));
+      break;
+    case VTableComponent::CK_RTTI:
+      Info.Components.push_back(VTableComponent::MakeRTTI(
+                                  GetLocalDeclAs<CXXRecordDecl>(F, Value)));
+      break;
+    case VTableComponent::CK_FunctionPointer:
+      Info.Components.push_back(VTableComponent::MakeFunction(
+                                  GetLocalDeclAs<CXXMethodDecl>(F, Value)));
+      break;
+    case VTableComponent::CK_CompleteDtorPointer:
+      Info.Components.push_back(VTableComponent::MakeCompleteDtor(
+                                  GetLocalDeclAs<CXXDestructorDecl>(F, Value)));
+      break;
+    case VTableComponent::CK_DeletingDtorPointer:
+      Info.Components.push_back(VTableComponent::MakeDeletingDtor(
+                                  GetLocalDeclAs<CXXDestructorDecl>(F, Value)));
+      break;
+    case VTableComponent::CK_UnusedFunctionPointer:
+      Info.Components.push_back(VTableComponent::MakeUnusedFunction(
+                                  GetLocalDeclAs<CXXMethodDecl>(F, Value)));
+      break;
+    }
+  }
+
+  unsigned NumVTableThunks = Data[Idx++];
+  for (unsigned I = 0; I != NumVTableThunks; ++I) {
+    uint64_t Index = Data[Idx++];
+    ThunkInfo Thunk = ReadThunkInfo(Data, Idx);
+    Info.VTableThunks.push_back(std::make_pair(Index, Thunk));
+  }
+
+  unsigned NumAddressPoints = Data[Idx++];
+  for (unsigned I = 0; I != NumAddressPoints; ++I) {
+    const CXXRecordDecl *Base = GetLocalDeclAs<CXXRecordDecl>(F, Data[Idx++]);
+    CharUnits BaseOffset = CharUnits::fromQuantity(Data[Idx++]);
+    Info.AddressPoints[BaseSubobject(Base, BaseOffset)] = Data[Idx++];
+  }
+
+  unsigned NumMethods = Data[Idx++];
+  for (unsigned I = 0; I != NumMethods; ++I) {
+    const CXXMethodDecl *MD = GetLocalDeclAs<CXXMethodDecl>(F, Data[Idx++]);
+    VTableLayout::ThunkInfoVectorTy MethodThunks;
+    for (unsigned T = 0, NT = Data[Idx++]; T != NT; ++T)
+      MethodThunks.push_back(ReadThunkInfo(Data, Idx));
+    Info.Thunks.push_back(std::make_pair(MD, MethodThunks));
+  }
+
+  unsigned NumVBases = Data[Idx++];
+  for (unsigned I = 0; I != NumVBases; ++I) {
+    const CXXRecordDecl *VBase = GetLocalDeclAs<CXXRecordDecl>(F, Data[Idx++]);
+    Info.VBaseOffsetOffsets.push_back(
+      std::make_pair(VBase, CharUnits::fromQuantity(Data[Idx++])));
+  }
+
+  assert(Idx == Known->second.Length && "Invalid vtable layout entry");
+  ++NumVTableLayoutsReused;
+  return true;
+}
+
 void ASTReader::ReadTentativeDefinitions(
                   SmallVectorImpl<VarDecl *> &TentativeDefs) {
   for (unsigned I = 0, N = TentativeDefinitions.size(); I != N; ++I) {
@@ -7151,6 +7387,7 @@ ASTReader::ASTReader(Preprocessor &PP, ASTContext &Context,
     UseGlobalIndex(UseGlobalIndex), TriedLoadingGlobalIndex(false),
     CurrentGeneration(0), CurrSwitchCaseStmts(&SwitchCaseStmts),
     NumSLocEntriesRead(0), TotalNumSLocEntries(0), 
+    NumRecordLayoutsReused(0), NumVTableLayoutsReused(0),
     NumStatementsRead(0), TotalNumStatements(0), NumMacrosRead(0),
     TotalNumMacros(0), NumIdentifierLookups(0), NumIdentifierLookupHits(0),
     NumSelectorsRead(0), NumMethodPoolEntriesRead(0),
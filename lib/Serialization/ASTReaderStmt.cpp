@@ -1813,15 +1813,17 @@ Stmt *ASTReader::ReadStmtFromStream(ModuleFile &F) {
       Expr *Base = ReadSubExpr();
       ValueDecl *MemberD = ReadDeclAs<ValueDecl>(F, Record, Idx);
       SourceLocation MemberLoc = ReadSourceLocation(F, Record, Idx);
-      DeclarationNameInfo MemberNameInfo(MemberD->getDeclName(), MemberLoc);
       bool IsArrow = Record[Idx++];
+      DeclarationNameLoc MemberDNLoc;
+      ReadDeclarationNameLoc(F, MemberDNLoc, MemberD->getDeclName(), Record,
+                             Idx);
+      DeclarationNameInfo MemberNameInfo(MemberD->getDeclName(), MemberLoc,
+                                         MemberDNLoc);
 
       S = MemberExpr::Create(Context, Base, IsArrow, QualifierLoc,
                              TemplateKWLoc, MemberD, FoundDecl, MemberNameInfo,
                              HasTemplateKWAndArgsInfo ? &ArgInfo : 0,
                              T, VK, OK);
-      ReadDeclarationNameLoc(F, cast<MemberExpr>(S)->MemberDNLoc,
-                             MemberD->getDeclName(), Record, Idx);
       if (HadMultipleCandidates)
         cast<MemberExpr>(S)->setHadMultipleCandidates(true);
       break;
@@ -20,8 +20,10 @@
 #include "clang/AST/DeclTemplate.h"
 #include "clang/AST/Expr.h"
 #include "clang/AST/ExprCXX.h"
+#include "clang/AST/RecordLayout.h"
 #include "clang/AST/Type.h"
 #include "clang/AST/TypeLocVisitor.h"
+#include "clang/AST/VTableBuilder.h"
 #include "clang/Basic/FileManager.h"
 #include "clang/Basic/FileSystemStatCache.h"
 #include "clang/Basic/OnDiskHashTable.h"
@@ -39,6 +41,7 @@
 #include "clang/Lex/PreprocessorOptions.h"
 #include "clang/Sema/IdentifierResolver.h"
 #include "clang/Sema/Sema.h"
+#include "clang/Sema/SemaDiagnostic.h"
 #include "clang/Serialization/ASTReader.h"
 #include "llvm/ADT/APFloat.h"
 #include "llvm/ADT/APInt.h"
@@ -826,6 +829,8 @@ void ASTWriter::WriteBlockInfoBlock() {
   RECORD(DELEGATING_CTORS);
   RECORD(KNOWN_NAMESPACES);
   RECORD(UNDEFINED_BUT_USED);
+  RECORD(RECORD_LAYOUTS);
+  RECORD(VTABLE_LAYOUTS);
   RECORD(MODULE_OFFSET_MAP);
   RECORD(SOURCE_MANAGER_LINE_TABLE);
   RECORD(OBJC_CATEGORIES_MAP);
@@ -3512,6 +3517,140 @@ static void AddLazyVectorDecls(ASTWriter &Writer, Vector &Vec,
   }
 }
 
+static void AddThunkInfo(const ThunkInfo &Thunk,
+                         ASTWriter::RecordData &Record) {
+  Record.push_back(Thunk.This.NonVirtual);
+  Record.push_back(Thunk.This.VCallOffsetOffset);
+  Record.push_back(Thunk.Return.NonVirtual);
+  Record.push_back(Thunk.Return.VBaseOffsetOffset);
+}
+
+/// \brief Whether laying out the given record, or a record it contains that has
+/// not been laid out yet, could warn about padding or unnecessary packing.
+static bool layoutMayWarn(DiagnosticsEngine &Diags, const RecordDecl *RD,
+    const llvm::DenseMap<const RecordDecl *, const ASTRecordLayout *> &LaidOut,
+    llvm::SmallPtrSet<const RecordDecl *, 16> &Visited) {
+  RD = RD->getDefinition();
+  if (!RD || LaidOut.count(RD) || !Visited.insert(RD))
+    return false;
+
+  SourceLocation Loc = RD->getLocation();
+  if (Diags.getDiagnosticLevel(diag::warn_padded_struct_field, Loc) !=
+        DiagnosticsEngine::Ignored ||
+      Diags.getDiagnosticLevel(diag::warn_padded_struct_anon_field, Loc) !=
+        DiagnosticsEngine::Ignored ||
+      Diags.getDiagnosticLevel(diag::warn_padded_struct_size, Loc) !=
+        DiagnosticsEngine::Ignored ||
+      Diags.getDiagnosticLevel(diag::warn_unnecessary_packed, Loc) !=
+        DiagnosticsEngine::Ignored)
+    return true;
+
+  if (const CXXRecordDecl *CXXRD = dyn_cast<CXXRecordDecl>(RD))
+    for (CXXRecordDecl::base_class_const_iterator B = CXXRD->bases_begin(),
+                                               BEnd = CXXRD->bases_end();
+         B != BEnd; ++B)
+      if (const CXXRecordDecl *Base = B->getType()->getAsCXXRecordDecl())
+        if (layoutMayWarn(Diags, Base, LaidOut, Visited))
+          return true;
+
+  for (RecordDecl::field_iterator F = RD->field_begin(),
+                               FEnd = RD->field_end();
+       F != FEnd; ++F) {
+    const Type *T = F->getType()->getBaseElementTypeUnsafe();
+    if (const RecordType *RT = T->getAs<RecordType>())
+      if (layoutMayWarn(Diags, RT->getDecl(), LaidOut, Visited))
+        return true;
+  }
+  return false;
+}
+
+/// \brief Add the vtable related information of a class to the record. The
+/// parts that come from hash tables are sorted by declaration ID, so that the
+/// output does not depend on their order.
+static void AddVTableLayoutInfo(ASTWriter &Writer, const VTableLayoutInfo &Info,
+                                ASTWriter::RecordData &Record) {
+  Record.push_back(Info.Components.size());
+  for (unsigned I = 0, N = Info.Components.size(); I != N; ++I) {
+    const VTableComponent &Component = Info.Components[I];
+    Record.push_back(Component.getKind());
+    switch (Component.getKind()) {
+    case VTableComponent::CK_VCallOffset:
+      Record.push_back(Component.getVCallOffset().getQuantity());
+      break;
+    case VTableComponent::CK_VBaseOffset:
+      Record.push_back(Component.getVBaseOffset().getQuantity());
+      break;
+    case VTableComponent::CK_OffsetToTop:
+      Record.push_back(Component.getOffsetToTop().getQuantity());
+      break;
+    case VTableComponent::CK_RTTI:
+      Writer.AddDeclRef(Component.getRTTIDecl(), Record);
+      break;
+    case VTableComponent::CK_FunctionPointer:
+      Writer.AddDeclRef(Component.getFunctionDecl(), Record);
+      break;
+    case VTableComponent::CK_CompleteDtorPointer:
+    case VTableComponent::CK_DeletingDtorPointer:
+      Writer.AddDeclRef(Component.getDestructorDecl(), Record);
+      break;
+    case VTableComponent::CK_UnusedFunctionPointer:
+      Writer.AddDeclRef(Component.getUnusedFunctionDecl(), Record);
+      break;
+    }
+  }
+
+  Record.push_back(Info.VTableThunks.size());
+  for (unsigned I = 0, N = Info.VTableThunks.size(); I != N; ++I) {
+    Record.push_back(Info.VTableThunks[I].first);
+    AddThunkInfo(Info.VTableThunks[I].second, Record);
+  }
+
+  // Address points, as (index, base ID, base offset).
+  typedef std::pair<uint64_t, std::pair<DeclID, int64_t> > AddressPointTy;
+  SmallVector<AddressPointTy, 4> AddressPoints;
+  for (VTableLayout::AddressPointsMapTy::const_iterator
+         I = Info.AddressPoints.begin(), E = Info.AddressPoints.end();
+       I != E; ++I) {
+    AddressPoints.push_back(std::make_pair(I->second,
+      std::make_pair(Writer.GetDeclRef(I->first.getBase()),
+                     I->first.getBaseOffset().getQuantity())));
+  }
+  std::sort(AddressPoints.begin(), AddressPoints.end());
+  Record.push_back(AddressPoints.size());
+  for (unsigned I = 0, N = AddressPoints.size(); I != N; ++I) {
+    Record.push_back(AddressPoints[I].second.first);
+    Record.push_back(AddressPoints[I].second.second);
+    Record.push_back(AddressPoints[I].first);
+  }
+
+  SmallVector<std::pair<DeclID, unsigned>, 4> Thunks;
+  for (unsigned I = 0, N = Info.Thunks.size(); I != N; ++I)
+    Thunks.push_back(std::make_pair(Writer.GetDeclRef(Info.Thunks[I].first),
+                                    I));
+  std::sort(Thunks.begin(), Thunks.end());
+  Record.push_back(Thunks.size());
+  for (unsigned I = 0, N = Thunks.size(); I != N; ++I) {
+    const VTableLayout::ThunkInfoVectorTy &MethodThunks
+      = Info.Thunks[Thunks[I].second].second;
+    Record.push_back(Thunks[I].first);
+    Record.push_back(MethodThunks.size());
+    for (unsigned T = 0, NT = MethodThunks.size(); T != NT; ++T)
+      AddThunkInfo(MethodThunks[T], Record);
+  }
+
+  SmallVector<std::pair<DeclID, int64_t>, 4> VBaseOffsetOffsets;
+  for (unsigned I = 0, N = Info.VBaseOffsetOffsets.size(); I != N; ++I)
+    VBaseOffsetOffsets.push_back(std::make_pair(
+      Writer.GetDeclRef(Info.VBaseOffsetOffsets[I].first),
+      Info.VBaseOffsetOffsets[I].second.getQuantity()));
+  std::sort(VBaseOffsetOffsets.begin(), VBaseOffsetOffsets.end());
+  Record.push_back(VBaseOffsetOffsets.size());
+  for (unsigned I = 0, N = VBaseOffsetOffsets.size(); I != N; ++I) {
+    Record.push_back(VBaseOffsetOffsets[I].first);
+    Record.push_back(VBaseOffsetOffsets[I].second);
+  }
+}
+
 void ASTWriter::WriteASTCore(Sema &SemaRef,
                              StringRef isysroot,
                              const std::string &OutputFile, 
@@ -3650,6 +3789,13 @@ void ASTWriter::WriteASTCore(Sema &SemaRef,
     AddDeclRef(I->first, PendingInstantiations);
     AddSourceLocation(I->second, PendingInstantiations);
   }
+  // Instantiations already performed while building this PCH are written as
+  // pending ones too; importers will find their definitions and reuse them.
+  for (unsigned I = 0, N = SemaRef.PrefixInstantiations.size(); I != N; ++I) {
+    AddDeclRef(SemaRef.PrefixInstantiations[I].first, PendingInstantiations);
+    AddSourceLocation(SemaRef.PrefixInstantiations[I].second,
+                      PendingInstantiations);
+  }
   assert(SemaRef.PendingLocalImplicitInstantiations.empty() &&
          "There are local ones at end of translation unit!");
 
@@ -3686,6 +3832,95 @@ void ASTWriter::WriteASTCore(Sema &SemaRef,
     AddSourceLocation(I->second, UndefinedButUsed);
   }
 
+  // Build a record containing the vtable related information of the dynamic
+  // classes defined in this file, which CodeGen would otherwise recompute in
+  // every importer that emits their vtables. Each entry is the class and the
+  // length of its information, so that readers can skip it until needed.
+  // This also lays out the classes, so do it before the record layouts are
+  // collected. Classes whose layout could warn about padding or packing are
+  // skipped unless they were already laid out, since the diagnostics would
+  // come too late to stop the file from being written. The number of classes
+  // is bounded to keep the cost of writing a large header in check; layouts
+  // that are only built to be dumped are not cached.
+  RecordData VTableLayouts;
+  if (!Context.getTargetInfo().getCXXABI().isMicrosoft() &&
+      !Context.getLangOpts().DumpVTableLayouts) {
+    const unsigned MaxVTableLayouts = 4096;
+    unsigned NumVTableLayouts = 0;
+    VTableContext VTables(Context);
+    for (Sema::DynamicClassesType::iterator
+           I = SemaRef.DynamicClasses.begin(0, true),
+           E = SemaRef.DynamicClasses.end();
+         I != E && NumVTableLayouts != MaxVTableLayouts; ++I) {
+      const CXXRecordDecl *RD = *I;
+      if (RD->isInvalidDecl() || !RD->hasDefinition() ||
+          RD->getDefinition() != RD)
+        continue;
+      llvm::SmallPtrSet<const RecordDecl *, 16> Visited;
+      if (layoutMayWarn(Context.getDiagnostics(), RD, Context.ASTRecordLayouts,
+                        Visited))
+        continue;
+
+      VTableLayoutInfo Info;
+      VTables.computeVTableLayoutInfo(RD, Info);
+      RecordData Entry;
+      AddVTableLayoutInfo(*this, Info, Entry);
+      AddDeclRef(RD, VTableLayouts);
+      VTableLayouts.push_back(Entry.size());
+      VTableLayouts.append(Entry.begin(), Entry.end());
+      ++NumVTableLayouts;
+    }
+  }
+
+  // Build a record containing the layouts of the records defined in this file
+  // which have been laid out, so that importers can reuse them. Each entry is
+  // the record, its size and alignment in bits, the offset of each field in
+  // bits, and the offset of each non-virtual base in chars.
+  //
+  // Classes with virtual bases are not written: a layout supplied from outside
+  // only carries the complete alignment, which would also become the
+  // non-virtual alignment used when the class is laid out as a base.
+  RecordData RecordLayouts;
+  SmallVector<std::pair<DeclID, const RecordDecl *>, 16> LaidOutRecords;
+  for (llvm::DenseMap<const RecordDecl*, const ASTRecordLayout*>::iterator
+         I = Context.ASTRecordLayouts.begin(),
+         E = Context.ASTRecordLayouts.end();
+       I != E; ++I) {
+    const RecordDecl *RD = I->first;
+    if (RD->isFromASTFile() || RD->isInvalidDecl())
+      continue;
+    if (const CXXRecordDecl *CXXRD = dyn_cast<CXXRecordDecl>(RD))
+      if (CXXRD->getNumVBases())
+        continue;
+    LaidOutRecords.push_back(std::make_pair(GetDeclRef(RD), RD));
+  }
+  // Sort by ID, so that the output does not depend on DenseMap order.
+  std::sort(LaidOutRecords.begin(), LaidOutRecords.end());
+  for (unsigned I = 0, N = LaidOutRecords.size(); I != N; ++I) {
+    const RecordDecl *RD = LaidOutRecords[I].second;
+    const ASTRecordLayout &Layout = Context.getASTRecordLayout(RD);
+    RecordLayouts.push_back(LaidOutRecords[I].first);
+    RecordLayouts.push_back(Context.toBits(Layout.getSize()));
+    RecordLayouts.push_back(Context.toBits(Layout.getAlignment()));
+    RecordLayouts.push_back(Layout.getFieldCount());
+    for (unsigned F = 0, NF = Layout.getFieldCount(); F != NF; ++F)
+      RecordLayouts.push_back(Layout.getFieldOffset(F));
+
+    const CXXRecordDecl *CXXRD = dyn_cast<CXXRecordDecl>(RD);
+    if (!CXXRD) {
+      RecordLayouts.push_back(0);
+      continue;
+    }
+    RecordLayouts.push_back(CXXRD->getNumBases());
+    for (CXXRecordDecl::base_class_const_iterator B = CXXRD->bases_begin(),
+                                               BEnd = CXXRD->bases_end();
+         B != BEnd; ++B) {
+      const CXXRecordDecl *Base = B->getType()->getAsCXXRecordDecl();
+      AddDeclRef(Base, RecordLayouts);
+      RecordLayouts.push_back(Layout.getBaseClassOffset(Base).getQuantity());
+    }
+  }
+
   // Write the control block
   WriteControlBlock(PP, Context, isysroot, OutputFile);
 
@@ -3904,6 +4139,14 @@ void ASTWriter::WriteASTCore(Sema &SemaRef,
   // Write the undefined internal functions and variables, and inline functions.
   if (!UndefinedButUsed.empty())
     Stream.EmitRecord(UNDEFINED_BUT_USED, UndefinedButUsed);
+
+  // Write the record containing the layouts of records.
+  if (!RecordLayouts.empty())
+    Stream.EmitRecord(RECORD_LAYOUTS, RecordLayouts);
+
+  // Write the vtable layouts of the dynamic classes.
+  if (!VTableLayouts.empty())
+    Stream.EmitRecord(VTABLE_LAYOUTS, VTableLayouts);
   
   // Write the visible updates to DeclContexts.
   for (llvm::SmallPtrSet<const DeclContext *, 16>::iterator
@@ -0,0 +1,20 @@
+// Matches in all translation units
+struct Point {
+  int x;
+  int y;
+};
+
+struct Line {
+  struct Point from, to;
+};
+
+struct Line line;
+
+// Differs in the third translation unit
+struct Inner {
+  int value;
+};
+
+struct Outer {
+  struct Inner *inner;
+};
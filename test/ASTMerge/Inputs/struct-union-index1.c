@@ -0,0 +1,6 @@
+// A struct with a single field
+struct U {
+  int value;
+};
+
+struct U u1;
@@ -0,0 +1,6 @@
+// A union with the same field
+union U {
+  int value;
+};
+
+union U u2;
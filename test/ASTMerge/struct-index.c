@@ -0,0 +1,18 @@
+// RUN: %clang_cc1 -emit-pch -o %t.1.ast %S/Inputs/struct-index1.c
+// RUN: %clang_cc1 -emit-pch -o %t.2.ast %S/Inputs/struct-index2.c
+// RUN: %clang_cc1 -emit-pch -o %t.3.ast %S/Inputs/struct-index3.c
+// RUN: %clang_cc1 -ast-merge %t.1.ast -ast-merge %t.2.ast -ast-merge %t.3.ast -fsyntax-only %s 2>&1 | FileCheck %s
+
+// The definitions from the third file have the same members as those in the
+// merged AST, but 'struct Outer' points to a different 'struct Inner', so it
+// must not be matched by its structural hash.
+
+// CHECK-NOT: 'struct Point'
+// CHECK-NOT: 'struct Line'
+// CHECK: struct-index1.c:14:8: warning: type 'struct Inner' has incompatible definitions in different translation units
+// CHECK: struct-index1.c:15:7: note: field 'value' has type 'int' here
+// CHECK: struct-index3.c:15:9: note: field 'value' has type 'float' here
+// CHECK: struct-index1.c:18:8: warning: type 'struct Outer' has incompatible definitions in different translation units
+// CHECK: struct-index1.c:19:17: note: field 'inner' has type 'struct Inner *' here
+// CHECK: struct-index3.c:19:17: note: field 'inner' has type 'struct Inner *' here
+// CHECK: 2 warnings generated
@@ -0,0 +1,10 @@
+// RUN: %clang_cc1 -emit-pch -o %t.1.ast %S/Inputs/struct-union-index1.c
+// RUN: %clang_cc1 -emit-pch -o %t.2.ast %S/Inputs/struct-union-index2.c
+// RUN: %clang_cc1 -ast-merge %t.1.ast -ast-merge %t.2.ast -fsyntax-only %s 2>&1 | FileCheck %s
+
+// The union has the same name and members as the struct in the merged AST,
+// so it must not be matched by its structural hash.
+
+// CHECK: struct-union-index1.c:2:8: warning: type 'struct U' has incompatible definitions in different translation units
+// CHECK: struct-union-index2.c:2:7: note: 'U' is a union here
+// CHECK: 1 warning generated
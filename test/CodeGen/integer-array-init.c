@@ -0,0 +1,16 @@
+// RUN: %clang_cc1 -triple x86_64-unknown-unknown -emit-llvm -o - %s | FileCheck %s
+
+// Integer literals initializing arrays of integers, with and without
+// conversions, are emitted with the right values.
+
+// CHECK: @bytes = global [8 x i8] c"\01\02\7F\80\FFa\00\03"
+unsigned char bytes[] = { 1, 2, 0x7f, 0x80, 0xff, 'a', 0, 3 };
+
+// CHECK: @shorts = global [4 x i16] [i16 1, i16 -1, i16 32767, i16 4]
+short shorts[] = { 1, -1, 32767, 4u };
+
+// CHECK: @wrapped = global [4 x i8] c"\01\02\00\03"
+unsigned char wrapped[] = { 1, 2, 256, 3 };
+
+// CHECK: @longs = global [3 x i64] [i64 1, i64 4294967295, i64 2]
+long longs[] = { 1, 0xffffffff, 2 };
@@ -0,0 +1,31 @@
+// RUN: %clang_cc1 -fsyntax-only -fmemory-report=%t.json %s
+// RUN: FileCheck %s < %t.json
+
+// CHECK: "categories": [
+// CHECK: {"name": "SourceManager", "bytes": {{[0-9]+}}, "entries": [
+// CHECK:   {"name": "local SLocEntries", "count": {{[0-9]+}}, "bytes":
+// CHECK: {"name": "Preprocessor", "bytes":
+// CHECK: {"name": "Macros", "bytes":
+// CHECK:   {"name": "macro definitions", "count": {{[1-9][0-9]*}}, "bytes":
+// CHECK: {"name": "Identifiers", "bytes":
+// CHECK: {"name": "ASTContext", "bytes":
+// CHECK: {"name": "LookupTables", "bytes":
+// CHECK: {"name": "Decls", "bytes":
+// CHECK:   {"name": "CXXRecord", "count": {{[1-9][0-9]*}}, "bytes":
+// CHECK: {"name": "Stmts", "bytes":
+// CHECK:   {"name": "ReturnStmt", "count": {{[1-9][0-9]*}}, "bytes":
+// CHECK: {"name": "Types", "bytes":
+// CHECK: {"name": "Sema", "bytes":
+
+#define SQUARE(X) ((X) * (X))
+
+template <typename T> struct Box {
+  T Value;
+  T get() const { return Value; }
+};
+
+struct Point { int X, Y; };
+
+int area(Box<Point> B) {
+  return SQUARE(B.get().X);
+}
@@ -0,0 +1,25 @@
+// RUN: %clang_cc1 -std=c++11 -fsyntax-only -ftime-trace=%t.json %s
+// RUN: FileCheck %s < %t.json
+
+// CHECK: "traceEvents": [
+// CHECK: "name": "table_size", "cat": "Constant Evaluation"
+// CHECK: "name": "instantiate Vector<int>", "cat": "Template Instantiation"
+// CHECK: "name": "operator+", "cat": "Overload Resolution"
+// CHECK: "displayTimeUnit": "ms"
+
+template <typename T> struct Vector {
+  T *Data;
+  unsigned Size;
+};
+
+struct Num { int V; };
+Num operator+(Num, Num);
+
+constexpr unsigned square(unsigned N) { return N * N; }
+constexpr unsigned table_size = square(16);
+
+void f(Num A, Num B) {
+  Vector<int> V;
+  (void)V;
+  (void)(A + B);
+}
@@ -0,0 +1,44 @@
+#include "complete-member-access-cached.h"
+
+void f(X x, X *px) {
+  x.member1 = 0;
+  px->func1();
+}
+
+void Y::doSomething() {
+  this->func2();
+}
+
+// Completion results for members of classes in the preamble are cached
+// across completions; the later (cached) runs must match the first one.
+// RUN: env CINDEXTEST_EDITING=1 CINDEXTEST_COMPLETION_CACHING=1 c-index-test -code-completion-at=%s:4:5 -I%S/Inputs %s | FileCheck -check-prefix=CHECK-DOT %s
+// CHECK-DOT: CXXMethod:{ResultType void}{TypedText func1}{LeftParen (}{RightParen )} (34)
+// CHECK-DOT: CXXMethod:{ResultType void}{TypedText func2}{LeftParen (}{RightParen )} (34) (inaccessible)
+// CHECK-DOT: CXXMethod:{ResultType void}{TypedText func3}{LeftParen (}{RightParen )} (34) (inaccessible)
+// CHECK-DOT: FieldDecl:{ResultType int}{TypedText member1} (35)
+// CHECK-DOT: FieldDecl:{ResultType int}{TypedText member2} (35) (inaccessible)
+// CHECK-DOT: FieldDecl:{ResultType int}{TypedText member3} (35) (inaccessible)
+// CHECK-DOT: CXXMethod:{ResultType X &}{TypedText operator=}{LeftParen (}{Placeholder const X &}{RightParen )} (34)
+// CHECK-DOT: StructDecl:{TypedText X}{Text ::} (75)
+// CHECK-DOT: CXXDestructor:{ResultType void}{TypedText ~X}{LeftParen (}{RightParen )} (34)
+// CHECK-DOT: Completion contexts:
+// CHECK-DOT-NEXT: Dot member access
+
+// RUN: env CINDEXTEST_EDITING=1 CINDEXTEST_COMPLETION_CACHING=1 c-index-test -code-completion-at=%s:5:7 -I%S/Inputs %s | FileCheck -check-prefix=CHECK-ARROW %s
+// CHECK-ARROW: CXXMethod:{ResultType void}{TypedText func1}{LeftParen (}{RightParen )} (34)
+// CHECK-ARROW: CXXMethod:{ResultType void}{TypedText func2}{LeftParen (}{RightParen )} (34) (inaccessible)
+// CHECK-ARROW: FieldDecl:{ResultType int}{TypedText member1} (35)
+// CHECK-ARROW: FieldDecl:{ResultType int}{TypedText member2} (35) (inaccessible)
+// CHECK-ARROW: Completion contexts:
+// CHECK-ARROW-NEXT: Arrow member access
+
+// Inside a member of a derived class, the protected members of the base
+// become accessible; the cached results for X above must not be reused.
+// RUN: env CINDEXTEST_EDITING=1 CINDEXTEST_COMPLETION_CACHING=1 c-index-test -code-completion-at=%s:9:9 -I%S/Inputs %s | FileCheck -check-prefix=CHECK-SUPER %s
+// CHECK-SUPER: CXXMethod:{ResultType void}{TypedText doSomething}{LeftParen (}{RightParen )} (34)
+// CHECK-SUPER: CXXMethod:{ResultType void}{Informative X::}{TypedText func1}{LeftParen (}{RightParen )} (36)
+// CHECK-SUPER: CXXMethod:{ResultType void}{Informative X::}{TypedText func2}{LeftParen (}{RightParen )} (36)
+// CHECK-SUPER: CXXMethod:{ResultType void}{Informative X::}{TypedText func3}{LeftParen (}{RightParen )} (36) (inaccessible)
+// CHECK-SUPER: FieldDecl:{ResultType int}{Informative X::}{TypedText member1} (37)
+// CHECK-SUPER: FieldDecl:{ResultType int}{Informative X::}{TypedText member2} (37)
+// CHECK-SUPER: FieldDecl:{ResultType int}{Informative X::}{TypedText member3} (37) (inaccessible)
@@ -0,0 +1,89 @@
+// Test this without pch.
+// RUN: %clang_cc1 -triple x86_64-apple-darwin10 -include %s -fsyntax-only -verify -std=c++11 %s
+// RUN: %clang_cc1 -triple x86_64-apple-darwin10 -include %s -fsyntax-only -std=c++11 -fdump-record-layouts %s 2>&1 | FileCheck %s
+
+// Test with pch.
+// RUN: %clang_cc1 -triple x86_64-apple-darwin10 -std=c++11 -emit-pch -o %t %s
+// RUN: %clang_cc1 -triple x86_64-apple-darwin10 -include-pch %t -fsyntax-only -verify -std=c++11 %s
+// RUN: %clang_cc1 -triple x86_64-apple-darwin10 -include-pch %t -emit-llvm-only -std=c++11 %s
+// RUN: %clang_cc1 -triple x86_64-apple-darwin10 -include-pch %t -fsyntax-only -std=c++11 -fdump-record-layouts %s 2>&1 | FileCheck %s
+// RUN: %clang_cc1 -triple x86_64-apple-darwin10 -include-pch %t -fsyntax-only -std=c++11 -print-stats %s 2>&1 | FileCheck --check-prefix=STATS %s
+// RUN: %clang_cc1 -triple x86_64-apple-darwin10 -include-pch %t -fsyntax-only -std=c++11 -Wpadded %s 2>&1 | FileCheck --check-prefix=PADDED %s
+
+// expected-no-diagnostics
+
+#ifndef HEADER
+#define HEADER
+
+struct Packed {
+  char c;
+  int i;
+  short s : 3;
+  short t : 9;
+} __attribute__((packed));
+
+struct Base {
+  virtual ~Base();
+  char b;
+};
+
+struct Empty {};
+
+struct VBase {
+  long long v;
+};
+
+struct Derived : Empty, Base, virtual VBase {
+  int d;
+};
+
+// A virtual base that is more aligned than the rest of the class, so that
+// the non-virtual alignment of OverAligned is less than its alignment.
+struct V {
+  long double x;
+};
+
+struct OverAligned : virtual V {
+  char c;
+};
+
+// Lay the records out while building the PCH.
+static_assert(sizeof(Packed) == 7, "");
+static_assert(__builtin_offsetof(Packed, i) == 1, "");
+static_assert(sizeof(Derived) > sizeof(Base), "");
+static_assert(alignof(OverAligned) == 16, "");
+
+#else
+
+static_assert(sizeof(Packed) == 7, "");
+static_assert(__builtin_offsetof(Packed, i) == 1, "");
+static_assert(alignof(Packed) == 1, "");
+static_assert(sizeof(Derived) > sizeof(Base), "");
+
+int get(Derived &d) { return d.d + d.b + d.v; }
+
+Packed p = { 1, 2, 3, 4 };
+
+// OverAligned is placed as a base according to its non-virtual alignment.
+struct Polymorphic {
+  virtual void f();
+};
+
+struct UsesOverAligned : Polymorphic, OverAligned {};
+static_assert(sizeof(UsesOverAligned) == 48, "");
+
+// CHECK: 0 | struct UsesOverAligned
+// CHECK-NEXT: 0 |   struct Polymorphic (primary base)
+// CHECK-NEXT: 0 |     (Polymorphic vtable pointer)
+// CHECK-NEXT: 8 |   struct OverAligned (base)
+// CHECK-NEXT: 8 |     (OverAligned vtable pointer)
+// CHECK-NEXT: 16 |     char c
+// CHECK-NEXT: 32 |   struct V (virtual base)
+// CHECK: nvsize=17, nvalign=8]
+
+// STATS: {{[1-9][0-9]*}}/{{[0-9]+}} record layouts reused
+
+// Layouts are not reused when they would be checked for padding.
+// PADDED: warning: padding size of 'Base' with 7 bytes to alignment boundary
+
+#endif
@@ -0,0 +1,76 @@
+// Test this without pch.
+// RUN: %clang_cc1 -triple x86_64-apple-darwin10 -std=c++11 -include %s -emit-llvm -o - %s | FileCheck %s
+
+// Test with pch.
+// RUN: %clang_cc1 -triple x86_64-apple-darwin10 -std=c++11 -emit-pch -o %t %s
+// RUN: %clang_cc1 -triple x86_64-apple-darwin10 -std=c++11 -include-pch %t -emit-llvm -o - %s | FileCheck %s
+// RUN: %clang_cc1 -triple x86_64-apple-darwin10 -std=c++11 -include-pch %t -emit-llvm -o /dev/null -print-stats %s 2>&1 | FileCheck --check-prefix=STATS %s
+
+// Classes that were not laid out while parsing are not laid out for the cache
+// when that could warn about padding.
+// RUN: %clang_cc1 -triple x86_64-apple-darwin10 -std=c++11 -Wpadded -emit-pch -o %t.padded -verify %s
+
+// expected-no-diagnostics
+
+#ifndef HEADER
+#define HEADER
+
+// A chain of primary bases.
+struct A {
+  virtual void f();
+  virtual ~A();
+};
+
+struct B : A {
+  virtual void g();
+  virtual void f();
+};
+
+struct C : B {
+  virtual void key();
+  virtual void g();
+};
+
+// Multiple and virtual inheritance, which need thunks and vbase offsets.
+struct V {
+  virtual void v();
+};
+
+struct D : A, virtual V {
+  virtual void key();
+  virtual void v();
+};
+
+// Lay the classes out while building the PCH.
+static_assert(sizeof(C) == sizeof(void *), "");
+static_assert(sizeof(D) > sizeof(A), "");
+
+// A class that is never used while building the PCH.
+struct E {
+  virtual void e() {}
+};
+
+// A class that is never used while building the PCH, and that is padded.
+struct Padded {
+  virtual void p();
+  char c;
+};
+
+#else
+
+// CHECK-DAG: @_ZTV1C = unnamed_addr constant [7 x i8*] [i8* null, i8* bitcast ({{.*}} @_ZTI1C to i8*), i8* bitcast ({{.*}} @_ZN1B1fEv to i8*), i8* bitcast ({{.*}} @_ZN1CD1Ev to i8*), i8* bitcast ({{.*}} @_ZN1CD0Ev to i8*), i8* bitcast ({{.*}} @_ZN1C1gEv to i8*), i8* bitcast ({{.*}} @_ZN1C3keyEv to i8*)]
+void C::key() {}
+
+// CHECK-DAG: @_ZTV1D = unnamed_addr constant {{.*}} @_ZTv0_n24_N1D1vEv
+// CHECK-DAG: define void @_ZTv0_n24_N1D1vEv(
+void D::key() {}
+void D::v() {}
+
+// CHECK-DAG: @_ZTV1E = linkonce_odr unnamed_addr constant {{.*}} @_ZN1E1eEv
+E *makeE() { return new E; }
+
+// All seven dynamic classes are cached, including those that were not laid
+// out while building the PCH.
+// STATS: {{[1-9]}}/7 vtable layouts reused
+
+#endif
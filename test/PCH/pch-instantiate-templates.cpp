@@ -0,0 +1,37 @@
+// Test without pch.
+// RUN: %clang_cc1 -triple x86_64-unknown-unknown -include %s %s -emit-llvm -o - | FileCheck %s
+
+// Test with pch, with and without instantiating templates in the pch.
+// RUN: %clang_cc1 -triple x86_64-unknown-unknown -x c++-header -emit-pch -o %t.1 %s
+// RUN: %clang_cc1 -triple x86_64-unknown-unknown -include-pch %t.1 %s -emit-llvm -o - | FileCheck %s
+// RUN: %clang_cc1 -triple x86_64-unknown-unknown -fpch-instantiate-templates -x c++-header -emit-pch -o %t.2 %s
+// RUN: %clang_cc1 -triple x86_64-unknown-unknown -include-pch %t.2 %s -emit-llvm -o - | FileCheck %s
+
+#ifndef HEADER
+#define HEADER
+
+template <typename T>
+struct Vec {
+  T *Begin;
+  T *End;
+  unsigned size() const { return End - Begin; }
+};
+
+template <typename T>
+T twice(T x) { return x + x; }
+
+inline unsigned header_use(const Vec<int> &V) {
+  return twice(V.size());
+}
+
+#else
+
+unsigned main_use(const Vec<int> &V) {
+  return header_use(V) + V.size();
+}
+
+// The definition of twice<unsigned> is instantiated in the header; it must
+// still be emitted when the PCH instantiated it.
+// CHECK: define linkonce_odr i32 @_Z5twiceIjET_S0_
+
+#endif
@@ -0,0 +1,31 @@
+// RUN: %clang_cc1 -fsyntax-only -verify %s
+
+// Delayed diagnostics for a single declarator that span several segments of
+// the delayed diagnostic pool.
+
+typedef int d0 __attribute__((deprecated)); // expected-note {{declared here}}
+typedef int d1 __attribute__((deprecated)); // expected-note {{declared here}}
+typedef int d2 __attribute__((deprecated)); // expected-note {{declared here}}
+typedef int d3 __attribute__((deprecated)); // expected-note {{declared here}}
+typedef int d4 __attribute__((deprecated)); // expected-note {{declared here}}
+typedef int d5 __attribute__((deprecated)); // expected-note {{declared here}}
+typedef int d6 __attribute__((deprecated)); // expected-note {{declared here}}
+typedef int d7 __attribute__((deprecated)); // expected-note {{declared here}}
+typedef int d8 __attribute__((deprecated)); // expected-note {{declared here}}
+typedef int d9 __attribute__((deprecated)); // expected-note {{declared here}}
+typedef int d10 __attribute__((deprecated)); // expected-note {{declared here}}
+typedef int d11 __attribute__((deprecated)); // expected-note {{declared here}}
+
+char a[sizeof(d0) // expected-warning {{'d0' is deprecated}}
+       + sizeof(d1) // expected-warning {{'d1' is deprecated}}
+       + sizeof(d2) // expected-warning {{'d2' is deprecated}}
+       + sizeof(d3) // expected-warning {{'d3' is deprecated}}
+       + sizeof(d4) // expected-warning {{'d4' is deprecated}}
+       + sizeof(d5) // expected-warning {{'d5' is deprecated}}
+       + sizeof(d6) // expected-warning {{'d6' is deprecated}}
+       + sizeof(d7) // expected-warning {{'d7' is deprecated}}
+       + sizeof(d8) // expected-warning {{'d8' is deprecated}}
+       + sizeof(d9) // expected-warning {{'d9' is deprecated}}
+       + sizeof(d10) // expected-warning {{'d10' is deprecated}}
+       + sizeof(d11) // expected-warning {{'d11' is deprecated}}
+       ];
@@ -0,0 +1,33 @@
+// RUN: %clang_cc1 -fsyntax-only -verify -Wformat %s
+// RUN: %clang_cc1 -fsyntax-only -Wformat -print-stats %s 2>&1 | FileCheck %s
+
+// Format strings are parsed once per translation unit and the result is
+// reused by every call with the same literal; each call must still be
+// diagnosed at its own location, with its own arguments.
+
+int printf(const char *restrict, ...);
+int scanf(const char *restrict, ...);
+
+#define LOG(...) printf(__VA_ARGS__)
+
+void test(int i, long l, char *s, int *ip) {
+  printf("%d %s\n", i, s);
+  printf("%d %s\n", l, s); // expected-warning{{format specifies type 'int' but the argument has type 'long'}}
+  printf("%d %s\n", i); // expected-warning{{more '%' conversions than data arguments}}
+  printf("%d %s\n", i, s, i); // expected-warning{{data argument not used by format string}}
+  LOG("%d %s\n", i, i); // expected-warning{{format specifies type 'char *' but the argument has type 'int'}}
+  LOG("%d %s\n", i, s);
+
+  printf("%y\n", i); // expected-warning{{invalid conversion specifier 'y'}}
+  printf("%y\n", i); // expected-warning{{invalid conversion specifier 'y'}}
+  printf("%d %", i); // expected-warning{{incomplete format specifier}}
+  printf("%d %", i); // expected-warning{{incomplete format specifier}}
+
+  // The same literal is parsed separately for scanf.
+  printf("%d", i);
+  scanf("%d", ip);
+  printf("%d", ip); // expected-warning{{format specifies type 'int' but the argument has type 'int *'}}
+  scanf("%d", i); // expected-warning{{format specifies type 'int *' but the argument has type 'int'}}
+}
+
+// CHECK: 14 format strings checked, 9 reused an earlier parse.
@@ -0,0 +1,36 @@
+// RUN: %clang_cc1 -fsyntax-only -verify -Wuninitialized -Wthread-safety %s
+// RUN: %clang_cc1 -fsyntax-only -Wuninitialized -Wthread-safety -print-stats %s 2>&1 | FileCheck %s
+
+// The uninitialized variables and thread safety analyses are skipped for
+// functions they cannot have anything to say about.
+
+void no_locals(int *p) {
+  *p = 0;
+}
+
+int uninit() {
+  int x; // expected-note {{initialize the variable 'x' to silence this warning}}
+  return x; // expected-warning {{variable 'x' is uninitialized when used here}}
+}
+
+class __attribute__((lockable)) Mutex {
+public:
+  void Lock() __attribute__((exclusive_lock_function));
+  void Unlock() __attribute__((unlock_function));
+};
+
+Mutex mu;
+int data __attribute__((guarded_by(mu)));
+
+void unlocked() {
+  data = 1; // expected-warning {{writing variable 'data' requires locking 'mu' exclusively}}
+}
+
+void locked() {
+  mu.Lock();
+  data = 1;
+  mu.Unlock();
+}
+
+// CHECK: 3 functions skipped uninitialized variables analysis (no tracked variables).
+// CHECK: 2 functions skipped thread safety analysis (no thread safety attributes).
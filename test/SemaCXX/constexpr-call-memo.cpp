@@ -0,0 +1,26 @@
+// RUN: %clang_cc1 -std=c++11 -fsyntax-only -verify %s
+// RUN: %clang_cc1 -std=c++11 -fsyntax-only -print-stats %s 2>&1 | FileCheck %s
+
+// Without memoization of constexpr calls, evaluating this takes time
+// exponential in n.
+constexpr unsigned long long fib(unsigned n) {
+  return n < 2 ? n : fib(n - 1) + fib(n - 2);
+}
+static_assert(fib(80) == 23416728348467685ULL, "");
+static_assert(fib(10) == 55, "");
+
+constexpr double halve(double d, int n) {
+  return n == 0 ? d : halve(d / 2, n - 1);
+}
+static_assert(halve(8.0, 3) == 1.0, "");
+static_assert(halve(-8.0, 3) == -1.0, "");
+
+// A call which is not a constant expression must still be diagnosed, even
+// after a call with other arguments has been remembered.
+constexpr int check(int n) {
+  return n > 0 ? n : throw 0; // expected-note {{subexpression not valid}}
+}
+static_assert(check(1) == 1, "");
+static_assert(check(0) == 0, ""); // expected-error {{not an integral constant expression}} expected-note {{in call to 'check(0)'}}
+
+// CHECK: constexpr call results cached
@@ -0,0 +1,28 @@
+// RUN: %clang_cc1 -std=c++11 -fsyntax-only -verify %s
+// expected-no-diagnostics
+
+// Reading an element of a constexpr array should not copy the whole array.
+// With 100000 elements, copying on every read makes this quadratic.
+
+#define E1 __COUNTER__,
+#define E10 E1 E1 E1 E1 E1 E1 E1 E1 E1 E1
+#define E100 E10 E10 E10 E10 E10 E10 E10 E10 E10 E10
+#define E1000 E100 E100 E100 E100 E100 E100 E100 E100 E100 E100
+#define E10000 E1000 E1000 E1000 E1000 E1000 E1000 E1000 E1000 E1000 E1000
+#define E100000 E10000 E10000 E10000 E10000 E10000 E10000 E10000 E10000 \
+                E10000 E10000
+
+constexpr long long table[] = { E100000 };
+static_assert(sizeof(table) / sizeof(table[0]) == 100000, "");
+
+constexpr long long sum(const long long *t, unsigned lo, unsigned hi) {
+  return hi - lo == 1 ? t[lo]
+                      : sum(t, lo, (lo + hi) / 2) + sum(t, (lo + hi) / 2, hi);
+}
+static_assert(sum(table, 0, 100000) == 4999950000LL, "");
+
+struct Pair { long long a[3]; int b; };
+constexpr Pair p = { { 1, 2, 3 }, 4 };
+static_assert(p.a[2] == 3 && p.b == 4, "");
+constexpr Pair get() { return p; }
+static_assert(get().b == 4, "");
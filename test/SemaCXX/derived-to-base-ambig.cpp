@@ -31,3 +31,21 @@ void overload_okay(E2*);
 void overload_call(F2* f2) {
   overload_okay(f2);
 }
+
+// A base within a virtual base is a single subobject, however many paths lead
+// to it, but not next to a non-virtual subobject of the same type.
+class Object3 { };
+class V3 : public Object3 { };
+class L3 : public virtual V3 { };
+class R3 : public virtual V3 { };
+class D3 : public L3, public R3 { };
+class N3 : public Object3 { };
+class E3 : public D3, public N3 { };
+
+void h(D3* d3, E3* e3) {
+  Object3* o3;
+  V3* v3;
+  o3 = d3;
+  v3 = e3;
+  o3 = e3; // expected-error{{ambiguous conversion from derived class 'E3' to base class 'Object3':}} expected-error{{assigning to 'Object3 *' from incompatible type 'E3 *'}}
+}
@@ -0,0 +1,38 @@
+// RUN: %clang_cc1 -fsyntax-only -fcxx-exceptions -verify -std=c++11 %s
+// expected-no-diagnostics
+
+// Compute the exception specifications of the implicit special members of
+// classes in deep hierarchies, where most bases and members are trivial.
+
+struct Trivial {};
+struct Throwing { Throwing() noexcept(false); ~Throwing() noexcept(false); };
+struct Virtual { virtual ~Virtual(); };
+
+template<int N, typename Leaf>
+struct Chain : Chain<N - 1, Leaf> { Trivial t[2]; };
+template<typename Leaf>
+struct Chain<0, Leaf> : Leaf {};
+
+static_assert(noexcept(Chain<200, Trivial>()), "");
+static_assert(noexcept(Chain<200, Trivial>().~Chain()), "");
+static_assert(!noexcept(Chain<200, Throwing>()), "");
+static_assert(!noexcept(Chain<200, Throwing>().~Chain()), "");
+static_assert(noexcept(Chain<200, Virtual>()), "");
+static_assert(noexcept(Chain<200, Virtual>().~Chain()), "");
+
+// Virtual bases are visited by every class in the hierarchy.
+template<int N, typename Leaf>
+struct VChain : virtual VChain<N - 1, Leaf> { Trivial t; };
+template<typename Leaf>
+struct VChain<0, Leaf> : virtual Leaf {};
+
+static_assert(noexcept(VChain<100, Trivial>()), "");
+static_assert(noexcept(VChain<100, Trivial>().~VChain()), "");
+static_assert(!noexcept(VChain<100, Throwing>()), "");
+static_assert(!noexcept(VChain<100, Throwing>().~VChain()), "");
+
+// A throwing member deep in the hierarchy is still seen.
+template<typename T> struct Holder { T t; };
+static_assert(!noexcept(Chain<100, Holder<Throwing> >()), "");
+static_assert(!noexcept(Chain<100, Holder<Throwing> >().~Chain()), "");
+static_assert(noexcept(Chain<100, Holder<Trivial[3]> >()), "");
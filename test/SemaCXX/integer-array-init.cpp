@@ -0,0 +1,41 @@
+// RUN: %clang_cc1 -fsyntax-only -verify -std=c++11 %s
+
+// Arrays of integers initialized by long runs of integer literals, as in
+// generated lookup tables.
+
+typedef unsigned char uint8;
+
+constexpr uint8 table[] = {
+  0x00, 0x01, 0x02, 0x03, 0x7f, 0x80, 0xfe, 0xff,
+  0x10, 'a', 'b', 0x20, 0, 1, 2, 3
+};
+static_assert(sizeof(table) == 16, "");
+static_assert(table[3] == 3 && table[6] == 0xfe && table[7] == 0xff, "");
+static_assert(table[9] == 'a' && table[15] == 3, "");
+
+constexpr short shorts[2][4] = {
+  { 1, 2, 3, 4 },
+  { 32767, 0, 5u, 6u }
+};
+static_assert(shorts[1][0] == 32767 && shorts[1][3] == 6, "");
+
+constexpr long long wide[] = { 1, 2, 0xffffffff, 3 };
+static_assert(wide[2] == 0xffffffffLL, "");
+
+// Values that do not fit are still diagnosed, wherever they appear.
+const uint8 bad[] = {
+  0x00, 0x01, 0x02, 0x03,
+  0x100, // expected-error {{cannot be narrowed}} expected-note {{inserting an explicit cast}} expected-warning {{changes value}}
+  0x04, 0x05
+};
+const signed char badsigned[] = {
+  1, 2, 3, 127,
+  128 // expected-error {{cannot be narrowed}} expected-note {{inserting an explicit cast}} expected-warning {{changes value}}
+};
+const unsigned short badunsigned[] = {
+  1u, 2u, 3u,
+  70000u // expected-error {{cannot be narrowed}} expected-note {{inserting an explicit cast}} expected-warning {{changes value}}
+};
+
+// Too many initializers are still diagnosed.
+const int toomany[3] = { 1, 2, 3, 4 }; // expected-error {{excess elements in array initializer}}
@@ -0,0 +1,21 @@
+// RUN: %clang_cc1 -fsyntax-only -verify %s
+// RUN: %clang_cc1 -fsyntax-only -print-stats %s 2>&1 | FileCheck %s
+// expected-no-diagnostics
+
+// Lookup into a namespace with many names builds its table in one pass.
+namespace N {
+#define F(X) void f##X(); void f##X(int); int v##X;
+#define F10(X) F(X##0) F(X##1) F(X##2) F(X##3) F(X##4) \
+               F(X##5) F(X##6) F(X##7) F(X##8) F(X##9)
+  F10(1) F10(2) F10(3) F10(4) F10(5) F10(6) F10(7) F10(8) F10(9)
+  inline namespace I { int inl; }
+  struct S;
+}
+
+void use() {
+  N::f10();
+  N::f99(1);
+  N::v55 = N::inl;
+}
+
+// CHECK: declaration lookup tables, {{[0-9]+}} names, {{[0-9]+}} overload vectors, {{[0-9]+}} bytes
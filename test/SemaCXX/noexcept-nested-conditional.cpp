@@ -0,0 +1,58 @@
+// RUN: %clang_cc1 -fsyntax-only -fcxx-exceptions -verify -std=c++11 %s
+// expected-no-diagnostics
+
+// Nested conditional noexcept-specifications, as generic libraries write
+// them. Each level calls the previous one several times, so the same callees
+// and subexpressions are checked over and over.
+
+struct Nothrow {};
+struct Throws { Throws(); };
+
+template<int N, typename T>
+struct Level {
+  static T make() noexcept(noexcept(Level<N - 1, T>::make()) &&
+                           noexcept((Level<N - 1, T>::make(),
+                                     Level<N - 1, T>::make(),
+                                     Level<N - 1, T>::make())));
+  static void use(T) noexcept(noexcept(Level<N - 1, T>::use(make())));
+};
+
+template<typename T>
+struct Level<0, T> {
+  static T make() noexcept(noexcept(T()));
+  static void use(T) noexcept;
+};
+
+static_assert(noexcept(Level<100, Nothrow>::make()), "");
+static_assert(noexcept(Level<100, Nothrow>::use(Nothrow())), "");
+static_assert(!noexcept(Level<100, Throws>::make()), "");
+static_assert(!noexcept(Level<100, Throws>::use(Throws())), "");
+
+// A long condition on a callee that is called many times.
+template<int N> struct Cond {
+  static void f() noexcept(noexcept(Cond<N - 1>::f()));
+};
+template<> struct Cond<0> { static void f() noexcept; };
+
+void g() noexcept(noexcept(Cond<100>::f()) && noexcept(Cond<99>::f()) &&
+                  noexcept(Cond<98>::f()) && noexcept(Cond<97>::f()) &&
+                  noexcept(Cond<96>::f()) && noexcept(Cond<95>::f()));
+void h() noexcept(false);
+
+#define CALLS4(F) F(), F(), F(), F()
+#define CALLS16(F) CALLS4(F), CALLS4(F), CALLS4(F), CALLS4(F)
+#define CALLS64(F) CALLS16(F), CALLS16(F), CALLS16(F), CALLS16(F)
+
+static_assert(noexcept((CALLS64(g), CALLS64(g), CALLS64(g))), "");
+static_assert(!noexcept((CALLS64(g), h(), CALLS64(g))), "");
+
+// A destructor declared without an exception specification only becomes
+// noexcept once its class is complete. Asking about it earlier, from within
+// the class, must not decide the answer for the rest of the translation unit.
+struct B {
+  ~B();
+  static const bool AskedInClass = noexcept(((B *)0)->~B());
+};
+B *b;
+static_assert(noexcept(b->~B()), "");
+static_assert(noexcept((b->~B(), b->~B())), "");
@@ -0,0 +1,37 @@
+// RUN: %clang_cc1 -fsyntax-only -verify %s
+// RUN: %clang_cc1 -fsyntax-only -print-stats %s 2>&1 | FileCheck %s
+// expected-no-diagnostics
+
+// Function types with long parameter lists and many specializations of the
+// same template land in the same uniquing tables; they are told apart by the
+// hashes of their profiles. There are several hundred specializations, more
+// than the buckets of the table they are uniqued in, so some of them share a
+// bucket with a different specialization, which the hash must reject.
+template<int N> struct I {};
+
+#define P4(T) T, T, T, T
+#define P16(T) P4(T), P4(T), P4(T), P4(T)
+
+template<int N> struct Many {
+  typedef void (*Fn)(P16(I<N>), P16(I<N + 1>));
+  Fn fn;
+};
+
+#define M(N) Many<N> m##N;
+#define M10(N) M(N##0) M(N##1) M(N##2) M(N##3) M(N##4) \
+               M(N##5) M(N##6) M(N##7) M(N##8) M(N##9)
+M10(1) M10(2) M10(3) M10(4) M10(5) M10(6) M10(7) M10(8) M10(9)
+
+template<int N, int K> struct Pair {};
+
+#define R(N) Pair<N, 0> r0_##N; Pair<N, 1> r1_##N; Pair<N, 2> r2_##N;
+#define R10(N) R(N##0) R(N##1) R(N##2) R(N##3) R(N##4) \
+               R(N##5) R(N##6) R(N##7) R(N##8) R(N##9)
+R10(1) R10(2) R10(3) R10(4) R10(5) R10(6) R10(7) R10(8) R10(9)
+
+void use() {
+  m10.fn = m11.fn;
+  m99.fn = 0;
+}
+
+// CHECK: {{[1-9][0-9]*}}/{{[0-9]+}} uniquing candidates rejected by profile hash
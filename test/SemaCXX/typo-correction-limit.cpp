@@ -0,0 +1,18 @@
+// RUN: %clang_cc1 -fsyntax-only -verify -fspell-checking-limit 1 %s
+
+namespace ns {
+  int counter; // expected-note 2{{'counter' declared here}}
+  int widget;
+}
+
+int a = ns::countr; // expected-error {{no member named 'countr' in namespace 'ns'; did you mean 'counter'?}}
+
+// The same typo in the same context is answered from the cache, even though
+// the spell-checking limit has been reached.
+int b = ns::countr; // expected-error {{no member named 'countr' in namespace 'ns'; did you mean 'counter'?}}
+
+// New typos are no longer corrected.
+int c = ns::widgt; // expected-error {{no member named 'widgt' in namespace 'ns'}}
+
+using namespace ns;
+int d = widgt; // expected-error {{use of undeclared identifier 'widgt'}}
@@ -0,0 +1,52 @@
+// RUN: %clang_cc1 -fsyntax-only -verify %s
+
+// Unqualified lookup through many nested namespaces and using-directives.
+// Names that are added to a namespace after a failed lookup must still be
+// found by later lookups.
+
+namespace n0 { int v0; }
+namespace n1 { int reached_through_n1; namespace inner { int w1; } }
+namespace n2 { int v2; using namespace n1::inner; }
+namespace n3 { int v3; using namespace n2; }
+namespace n4 { int v4; using namespace n3; }
+namespace n5 { int v5; using namespace n4; using namespace n0; }
+
+namespace outer {
+  namespace middle {
+    namespace innermost {
+      using namespace n5;
+
+      int f() {
+        return v0 + v2 + v3 + v4 + v5 + w1;
+      }
+
+      int g() {
+        return late; // expected-error {{use of undeclared identifier 'late'}}
+      }
+    }
+  }
+}
+
+namespace n3 { int late; }
+
+namespace outer {
+  namespace middle {
+    namespace innermost {
+      int h() {
+        return late + reached_through_n1; // expected-error {{use of undeclared identifier 'reached_through_n1'}}
+      }
+    }
+  }
+}
+
+namespace n2 { using namespace n1; }
+
+namespace outer {
+  namespace middle {
+    namespace innermost {
+      int k() {
+        return late + reached_through_n1;
+      }
+    }
+  }
+}
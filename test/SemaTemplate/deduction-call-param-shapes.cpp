@@ -0,0 +1,76 @@
+// RUN: %clang_cc1 -fsyntax-only -verify -std=c++11 %s
+
+// Deduction from calls to function templates whose parameters have the
+// common shapes "cv T" and "cv T&", mixed with parameters that need the
+// general deduction machinery.
+
+template<typename T, typename U> struct is_same { static const bool value = false; };
+template<typename T> struct is_same<T, T> { static const bool value = true; };
+
+template<typename T> T byValue(T);
+template<typename T> T byConstValue(const T);
+template<typename T> T &byRef(T &);
+template<typename T> T &byConstRef(const T &);
+template<typename T> T &byVolatileRef(volatile T &);
+
+void f(int);
+int arr[3];
+const int carr[3] = { 1, 2, 3 };
+const int ci = 0;
+volatile long vl = 0;
+typedef const int CInt;
+CInt cti = 0;
+
+static_assert(is_same<decltype(byValue(0)), int>::value, "");
+static_assert(is_same<decltype(byValue(ci)), int>::value, "");
+static_assert(is_same<decltype(byValue(cti)), int>::value, "");
+static_assert(is_same<decltype(byValue(arr)), int*>::value, "");
+static_assert(is_same<decltype(byValue(carr)), const int*>::value, "");
+static_assert(is_same<decltype(byValue(f)), void(*)(int)>::value, "");
+static_assert(is_same<decltype(byValue(&ci)), const int*>::value, "");
+static_assert(is_same<decltype(byConstValue(ci)), int>::value, "");
+
+static_assert(is_same<decltype(byRef(ci)), const int&>::value, "");
+static_assert(is_same<decltype(byRef(cti)), const int&>::value, "");
+static_assert(is_same<decltype(byRef(vl)), volatile long&>::value, "");
+static_assert(is_same<decltype(byRef(arr)), int(&)[3]>::value, "");
+static_assert(is_same<decltype(byRef(carr)), const int(&)[3]>::value, "");
+static_assert(is_same<decltype(byConstRef(0)), int&>::value, "");
+static_assert(is_same<decltype(byConstRef(ci)), int&>::value, "");
+static_assert(is_same<decltype(byConstRef(vl)), volatile long&>::value, "");
+static_assert(is_same<decltype(byConstRef(carr)), int(&)[3]>::value, "");
+static_assert(is_same<decltype(byVolatileRef(vl)), long&>::value, "");
+static_assert(is_same<decltype(byVolatileRef(ci)), const int&>::value, "");
+
+// Inconsistent deductions across parameters.
+template<typename T> void same(T, const T &); // expected-note {{deduced conflicting types for parameter 'T' ('int' vs. 'long')}}
+void test_same() {
+  same(1, 2);
+  same(ci, ci);
+  same(1, 2L); // expected-error {{no matching function}}
+}
+
+// Parameters that do not participate in deduction, or need the general path.
+template<typename T> struct identity { typedef T type; };
+template<typename T> T nondeduced(typename identity<T>::type, T);
+template<typename T> T pointer(const T *, T &&);
+template<typename T, typename ...Ts> T variadic(T, Ts &...);
+
+static_assert(is_same<decltype(nondeduced(1.0, 2)), int>::value, "");
+static_assert(is_same<decltype(pointer(&ci, 0)), int>::value, "");
+static_assert(is_same<decltype(variadic(ci, vl, arr)), int>::value, "");
+
+// Overloaded functions as arguments.
+void g(int);
+void g(double);
+template<typename T> void takesFn(T); // expected-note {{couldn't infer template argument 'T'}}
+template<typename T> void takesFnPtr(void (*)(T), T);
+void test_overloaded() {
+  takesFn(g); // expected-error {{no matching function}}
+  takesFnPtr(g, 1.0);
+  takesFn(f);
+}
+
+// Explicitly-specified template arguments.
+static_assert(is_same<decltype(byValue<long>(0)), long>::value, "");
+static_assert(is_same<decltype(same<long>(0, 0L)), void>::value, "");
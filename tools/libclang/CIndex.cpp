@@ -25,6 +25,7 @@
 #include "SimpleFormatContext.h"
 #include "clang/AST/StmtVisitor.h"
 #include "clang/Basic/Diagnostic.h"
+#include "clang/Basic/MemoryReport.h"
 #include "clang/Basic/Version.h"
 #include "clang/Frontend/ASTUnit.h"
 #include "clang/Frontend/CompilerInstance.h"
@@ -33,6 +34,7 @@
 #include "clang/Lex/Lexer.h"
 #include "clang/Lex/PreprocessingRecord.h"
 #include "clang/Lex/Preprocessor.h"
+#include "clang/Sema/Sema.h"
 #include "llvm/ADT/Optional.h"
 #include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/StringSwitch.h"
@@ -6120,6 +6122,12 @@ const char *clang_getTUResourceUsageName(CXTUResourceUsageKind kind) {
     case CXTUResourceUsage_Preprocessor_HeaderSearch:
       str = "Preprocessor: header search tables";
       break;
+    case CXTUResourceUsage_AST_LookupTables:
+      str = "ASTContext: lookup tables";
+      break;
+    case CXTUResourceUsage_Sema:
+      str = "Sema: allocator and tables";
+      break;
   }
   return str;
 }
@@ -6208,6 +6216,21 @@ CXTUResourceUsage clang_getCXTUResourceUsage(CXTranslationUnit TU) {
   createCXTUResourceUsageEntry(*entries,
                                CXTUResourceUsage_Preprocessor_HeaderSearch,
                                pp.getHeaderSearchInfo().getTotalMemory());
+
+  // How much memory is used by DeclContext lookup tables? They are allocated
+  // on the heap, not in the AST allocator.
+  unsigned numMaps, numNames, numVectors;
+  createCXTUResourceUsageEntry(*entries, CXTUResourceUsage_AST_LookupTables,
+    (unsigned long) astContext.getDeclContextMapsMemory(numMaps, numNames,
+                                                        numVectors));
+
+  // How much memory is used by Sema?
+  if (astUnit->hasSema()) {
+    MemoryReport report;
+    astUnit->getSema().reportMemoryUsage(report);
+    createCXTUResourceUsageEntry(*entries, CXTUResourceUsage_Sema,
+      (unsigned long) report.getCategoryBytes("Sema"));
+  }
   
   CXTUResourceUsage usage = { (void*) entries.get(),
                             (unsigned) entries->size(),
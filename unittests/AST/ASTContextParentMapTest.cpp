@@ -7,11 +7,13 @@
 //
 //===----------------------------------------------------------------------===//
 //
-// Tests for the getParents(...) methods of ASTContext.
+// Tests for the getParents(...) methods of ASTContext and for the parent
+// index they are built on.
 //
 //===----------------------------------------------------------------------===//
 
 #include "clang/AST/ASTContext.h"
+#include "clang/AST/ParentIndex.h"
 #include "clang/ASTMatchers/ASTMatchFinder.h"
 #include "clang/ASTMatchers/ASTMatchers.h"
 #include "clang/Tooling/Tooling.h"
@@ -67,5 +69,70 @@ TEST(GetParents, ReturnsMultipleParentsInTemplateInstantiations) {
                 hasAncestor(recordDecl(unless(isTemplateInstantiation())))))));
 }
 
+namespace {
+
+class CheckParentIndex : public MatchFinder::MatchCallback {
+public:
+  unsigned NumFound;
+  unsigned Depth;
+  bool ReachesTranslationUnit;
+  bool HasDuplicateParents;
+
+  CheckParentIndex()
+    : NumFound(0), Depth(0), ReachesTranslationUnit(false),
+      HasDuplicateParents(false) {}
+
+  virtual void run(const MatchFinder::MatchResult &Result) {
+    const ReturnStmt *Return = Result.Nodes.getStmtAs<ReturnStmt>("return");
+    if (!Return)
+      return;
+    ++NumFound;
+
+    const ParentIndex &Index = Result.Context->getParentIndex();
+    ParentIndex::NodeID ID =
+        Index.getNodeID(ast_type_traits::DynTypedNode::create(*Return));
+    ASSERT_NE(ParentIndex::InvalidNodeID, ID);
+
+    Depth = 0;
+    while (!Index.getParentIDs(ID).empty()) {
+      ID = Index.getParentIDs(ID)[0];
+      ++Depth;
+    }
+    ReachesTranslationUnit =
+        Index.getNode(ID).get<TranslationUnitDecl>() ==
+        Result.Context->getTranslationUnitDecl();
+
+    for (ParentIndex::NodeID Node = 0; Node != Index.size(); ++Node) {
+      ArrayRef<ParentIndex::NodeID> Parents = Index.getParentIDs(Node);
+      for (unsigned I = 0; I != Parents.size(); ++I)
+        for (unsigned J = 0; J != I; ++J)
+          if (Parents[I] == Parents[J])
+            HasDuplicateParents = true;
+    }
+  }
+};
+
+} // end anonymous namespace
+
+TEST(ParentIndex, WalksUpToTranslationUnitWithoutDuplicates) {
+  CheckParentIndex Callback;
+  MatchFinder Finder;
+  Finder.addMatcher(returnStmt(hasAncestor(functionDecl(hasName("f"))))
+                        .bind("return"),
+                    &Callback);
+  OwningPtr<FrontendActionFactory> Factory(newFrontendActionFactory(&Finder));
+
+  // The body of the non-template function is reached once; the members of
+  // C<int> are reached both from the template and from the specialization.
+  ASSERT_TRUE(tooling::runToolOnCode(
+      Factory->create(),
+      "template<typename T> struct C { T g() { return T(); } };"
+      "int f() { C<int> c; if (true) { { return c.g(); } } return 0; }"));
+  EXPECT_EQ(2u, Callback.NumFound);
+  EXPECT_TRUE(Callback.ReachesTranslationUnit);
+  EXPECT_FALSE(Callback.HasDuplicateParents);
+  EXPECT_LT(0u, Callback.Depth);
+}
+
 } // end namespace ast_matchers
 } // end namespace clang
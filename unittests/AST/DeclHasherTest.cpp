@@ -0,0 +1,111 @@
+//===- unittests/AST/DeclHasherTest.cpp --- Declaration hash tests --------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file contains tests for DeclHasher.
+//
+//===----------------------------------------------------------------------===//
+
+#include "clang/AST/ASTContext.h"
+#include "clang/AST/DeclHasher.h"
+#include "clang/ASTMatchers/ASTMatchFinder.h"
+#include "clang/Tooling/Tooling.h"
+#include "gtest/gtest.h"
+
+using namespace clang;
+using namespace ast_matchers;
+using namespace tooling;
+
+namespace {
+
+class HashMatch : public MatchFinder::MatchCallback {
+public:
+  DeclHash Hash;
+  unsigned NumFound;
+
+  HashMatch() : NumFound(0) {}
+
+  virtual void run(const MatchFinder::MatchResult &Result) {
+    const Decl *D = Result.Nodes.getDeclAs<Decl>("id");
+    if (!D || D->isImplicit())
+      return;
+    ++NumFound;
+    DeclHasher Hasher(*Result.Context);
+    Hash = Hasher.hash(D);
+  }
+};
+
+// Compute the hash of the declaration named 'f' in the given code.
+DeclHash hashOf(StringRef Code) {
+  HashMatch Callback;
+  MatchFinder Finder;
+  Finder.addMatcher(namedDecl(hasName("f")).bind("id"), &Callback);
+  OwningPtr<FrontendActionFactory> Factory(newFrontendActionFactory(&Finder));
+  std::vector<std::string> Args;
+  Args.push_back("-std=c++11");
+  EXPECT_TRUE(runToolOnCodeWithArgs(Factory->create(), Code, Args));
+  EXPECT_EQ(1u, Callback.NumFound);
+  return Callback.Hash;
+}
+
+TEST(DeclHasher, IgnoresLocationsAndParameterNames) {
+  EXPECT_EQ(hashOf("int g(int);\n"
+                   "int f(int x) { return g(x) + 1; }"),
+            hashOf("int g(int);\n\n\n"
+                   "int f(int y) {\n  return g(y)   + 1;\n}"));
+  EXPECT_EQ(hashOf("struct S { int a; }; int f(S s) { return s.a; }"),
+            hashOf("struct S { int a; };\n"
+                   "// A comment.\n"
+                   "int f(S s) { return s.a; }"));
+}
+
+TEST(DeclHasher, DetectsChanges) {
+  DeclHash Base = hashOf("int f(int x) { return x + 1; }");
+  EXPECT_NE(Base, hashOf("int f(int x) { return x + 2; }"));
+  EXPECT_NE(Base, hashOf("int f(int x) { return x - 1; }"));
+  EXPECT_NE(Base, hashOf("long f(int x) { return x + 1; }"));
+  EXPECT_NE(Base, hashOf("static int f(int x) { return x + 1; }"));
+  EXPECT_NE(Base, hashOf("__attribute__((noinline)) int f(int x) {\n"
+                         "  return x + 1;\n"
+                         "}"));
+  EXPECT_NE(hashOf("int g(int); int h(int);\n"
+                   "int f(int x) { return g(x); }"),
+            hashOf("int g(int); int h(int);\n"
+                   "int f(int x) { return h(x); }"));
+}
+
+TEST(DeclHasher, HashesRecordsAndVariables) {
+  EXPECT_EQ(hashOf("struct f { int a; char b; };"),
+            hashOf("struct f {\n  int a;\n  char b;\n};"));
+  EXPECT_NE(hashOf("struct f { int a; char b; };"),
+            hashOf("struct f { char b; int a; };"));
+  EXPECT_NE(hashOf("int f = 1;"), hashOf("int f = 2;"));
+}
+
+TEST(DeclHasher, IgnoresLocationsOfUnnamedTypes) {
+  EXPECT_EQ(hashOf("struct { int a; } s;\n"
+                   "int f() { return s.a; }"),
+            hashOf("\n\n"
+                   "struct {\n  int a;\n} s;\n"
+                   "int f() { return s.a; }"));
+  EXPECT_EQ(hashOf("void g(int);\n"
+                   "void f() { auto l = [](int x) { g(x); }; l(1); }"),
+            hashOf("void g(int);\n\n"
+                   "void f() {\n"
+                   "  auto l = [](int x) {\n    g(x);\n  };\n"
+                   "  l(1);\n"
+                   "}"));
+  EXPECT_NE(hashOf("struct { int a; } s; struct { int a; } t;\n"
+                   "decltype(s) *f;"),
+            hashOf("struct { int a; } s; struct { int a; } t;\n"
+                   "decltype(t) *f;"));
+  EXPECT_NE(hashOf("void f() { auto l = [](int x) { return x; }; }"),
+            hashOf("void f() { auto l = [](long x) { return x; }; }"));
+}
+
+} // end anonymous namespace
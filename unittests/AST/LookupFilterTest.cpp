@@ -0,0 +1,76 @@
+//===- unittests/AST/LookupFilterTest.cpp --- Lookup name filter tests ----===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file contains tests for the name filter of DeclContext lookup tables.
+//
+//===----------------------------------------------------------------------===//
+
+#include "clang/AST/ASTContext.h"
+#include "clang/AST/DeclContextInternals.h"
+#include "clang/ASTMatchers/ASTMatchFinder.h"
+#include "clang/Tooling/Tooling.h"
+#include "llvm/Support/raw_ostream.h"
+#include "gtest/gtest.h"
+
+using namespace clang;
+using namespace ast_matchers;
+using namespace tooling;
+
+namespace {
+
+const unsigned NumNames = 2000;
+
+std::string nameOf(StringRef Prefix, unsigned I) {
+  std::string Name;
+  llvm::raw_string_ostream OS(Name);
+  OS << Prefix << I;
+  return OS.str();
+}
+
+class FilterMatch : public MatchFinder::MatchCallback {
+public:
+  unsigned NumPresentRejected;
+  unsigned NumAbsentAccepted;
+
+  FilterMatch() : NumPresentRejected(0), NumAbsentAccepted(0) {}
+
+  virtual void run(const MatchFinder::MatchResult &Result) {
+    const NamespaceDecl *NS = Result.Nodes.getDeclAs<NamespaceDecl>("ns");
+    StoredDeclsMap *Map = NS->getPrimaryContext()->buildLookup();
+    ASSERT_TRUE(Map != 0);
+
+    IdentifierTable &Idents = Result.Context->Idents;
+    for (unsigned I = 0; I != NumNames; ++I) {
+      if (!Map->mayContain(&Idents.get(nameOf("present", I))))
+        ++NumPresentRejected;
+      if (Map->mayContain(&Idents.get(nameOf("absent", I))))
+        ++NumAbsentAccepted;
+    }
+  }
+};
+
+TEST(LookupFilter, RejectsMostAbsentNamesInLargeContexts) {
+  std::string Code = "namespace N {\n";
+  for (unsigned I = 0; I != NumNames; ++I)
+    Code += "int " + nameOf("present", I) + ";\n";
+  Code += "}\n";
+
+  FilterMatch Callback;
+  MatchFinder Finder;
+  Finder.addMatcher(namespaceDecl(hasName("N")).bind("ns"), &Callback);
+  OwningPtr<FrontendActionFactory> Factory(newFrontendActionFactory(&Finder));
+  ASSERT_TRUE(runToolOnCode(Factory->create(), Code));
+
+  // The filter must never reject a name in the map, and must stay selective
+  // however many names the map holds.
+  EXPECT_EQ(0u, Callback.NumPresentRejected);
+  EXPECT_LT(Callback.NumAbsentAccepted, NumNames / 10);
+}
+
+} // end anonymous namespace